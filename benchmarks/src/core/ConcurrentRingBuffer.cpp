@@ -0,0 +1,144 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto CAPACITY          = 1'024u;
+    constexpr auto VALUES_PER_THREAD = 1'000'000u;
+    constexpr auto ROUND_TRIPS       = 100'000u;
+    constexpr auto BATCH_SIZE        = 32u;
+
+    /// `producer_count` threads push VALUES_PER_THREAD values each while `consumer_count`
+    /// threads pop them all
+    template<class Buffer>
+    auto throughput(bench::State& state, Int producer_count, Int consumer_count) -> void {
+        const auto total = as<UInt64>(producer_count) * VALUES_PER_THREAD;
+
+        state.run(total, [producer_count, consumer_count, total] {
+            auto buffer = Buffer { CAPACITY };
+            auto popped = std::atomic<UInt64> { 0 };
+
+            auto threads = std::vector<std::jthread> {};
+            for (auto _ : range(consumer_count))
+                threads.emplace_back([&buffer, &popped, total] {
+                    auto sum = UInt64 { 0 };
+                    while (popped.load(std::memory_order_relaxed) < total) {
+                        if (const auto value = buffer.tryPop(); value) {
+                            sum += *value;
+                            popped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                    bench::doNotOptimize(sum);
+                });
+            for (auto _ : range(producer_count))
+                threads.emplace_back([&buffer] {
+                    for (auto value = UInt64 { 0 }; value < VALUES_PER_THREAD;)
+                        if (buffer.tryPush(value)) ++value;
+                });
+        });
+    }
+
+    /// 1 -> 1 moving BATCH_SIZE values at once
+    template<class Buffer>
+    auto batchThroughput(bench::State& state) -> void {
+        state.run(VALUES_PER_THREAD, [] {
+            auto buffer = Buffer { CAPACITY };
+
+            auto consumer = std::jthread { [&buffer] {
+                auto values = std::array<UInt64, BATCH_SIZE> {};
+                auto sum    = UInt64 { 0 };
+                for (auto popped = UInt64 { 0 }; popped < VALUES_PER_THREAD;) {
+                    const auto count = buffer.tryPopBatch(values);
+                    for (auto i : range(count)) sum += values[i];
+                    popped += count;
+                }
+                bench::doNotOptimize(sum);
+            } };
+
+            auto values = std::array<UInt64, BATCH_SIZE> {};
+            std::ranges::iota(values, UInt64 { 0 });
+            for (auto pushed = UInt64 { 0 }; pushed < VALUES_PER_THREAD;)
+                pushed += buffer.tryPushBatch(
+                    std::span { values }.first(std::min<UInt64>(BATCH_SIZE,
+                                                                VALUES_PER_THREAD - pushed)));
+        });
+    }
+
+    /// 1 -> 1 through the blocking wrapper, the threads park instead of spinning
+    template<class Buffer>
+    auto blockingThroughput(bench::State& state) -> void {
+        state.run(VALUES_PER_THREAD, [] {
+            auto buffer = BlockingRingBuffer<Buffer> { CAPACITY };
+
+            auto consumer = std::jthread { [&buffer] {
+                auto sum = UInt64 { 0 };
+                while (const auto value = buffer.pop()) sum += *value;
+                bench::doNotOptimize(sum);
+            } };
+
+            for (auto value : range(UInt64 { VALUES_PER_THREAD })) buffer.push(value);
+            buffer.close();
+        });
+    }
+
+    /// ping pong between two threads through two buffers, one operation is a round trip
+    template<class Buffer>
+    auto latency(bench::State& state) -> void {
+        auto ping = Buffer { CAPACITY };
+        auto pong = Buffer { CAPACITY };
+
+        auto stop   = std::atomic_bool { false };
+        auto echoer = std::jthread { [&ping, &pong, &stop] {
+            while (not stop.load(std::memory_order_relaxed))
+                if (const auto value = ping.tryPop(); value)
+                    while (not pong.tryPush(*value)) {}
+        } };
+
+        state.run(ROUND_TRIPS, [&ping, &pong] {
+            for (auto value : range(UInt64 { ROUND_TRIPS })) {
+                while (not ping.tryPush(value)) {}
+
+                auto answer = std::optional<UInt64> {};
+                while (not answer) answer = pong.tryPop();
+                bench::doNotOptimize(answer);
+            }
+        });
+
+        stop = true;
+    }
+
+    auto makeBenchmarks() -> std::vector<bench::BenchmarkFunc> {
+        const auto hardware_concurrency
+            = std::max(as<Int>(std::thread::hardware_concurrency()), Int { 2 });
+        const auto half = hardware_concurrency / 2;
+
+        return {
+            { "throughput.spsc.1-1",
+             [](bench::State& state) { throughput<SPSCRingBuffer<UInt64>>(state, 1, 1); } },
+            { "throughput.mpmc.1-1",
+             [](bench::State& state) { throughput<MPMCRingBuffer<UInt64>>(state, 1, 1); } },
+            { "throughput.mpmc.2-2",
+             [](bench::State& state) { throughput<MPMCRingBuffer<UInt64>>(state, 2, 2); } },
+            { std::format("throughput.mpmc.{}-{}", half, half),
+             [half](bench::State& state) {
+                 throughput<MPMCRingBuffer<UInt64>>(state, half, half);
+             } },
+            { "throughput.spsc.batch", batchThroughput<SPSCRingBuffer<UInt64>> },
+            { "throughput.mpmc.batch", batchThroughput<MPMCRingBuffer<UInt64>> },
+            { "throughput.spsc.blocking", blockingThroughput<SPSCRingBuffer<UInt64>> },
+            { "throughput.mpmc.blocking", blockingThroughput<MPMCRingBuffer<UInt64>> },
+            { "latency.spsc", latency<SPSCRingBuffer<UInt64>> },
+            { "latency.mpmc", latency<MPMCRingBuffer<UInt64>> },
+        };
+    }
+
+    auto _ = bench::BenchmarkSuite { "Core.ConcurrentRingBuffer", makeBenchmarks() };
+} // namespace
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto CHAIN_LENGTH = 10'000u;
+    constexpr auto FAN_OUT      = 256u;
+
+    auto leaf(UInt32 value) -> Task<UInt32> {
+        co_return value;
+    }
+
+    /// awaits CHAIN_LENGTH tasks in a row, the frames are recycled by the frame allocator
+    auto chain() -> Task<UInt32> {
+        auto sum = 0u;
+        for (auto i : range(CHAIN_LENGTH)) sum += co_await leaf(i);
+
+        co_return sum;
+    }
+
+    auto onWorker(ThreadPool& pool, UInt32 value) -> Task<UInt32> {
+        co_await pool.schedule();
+
+        co_return value;
+    }
+
+    auto fanOut(ThreadPool& pool) -> Task<UInt32> {
+        auto tasks = std::vector<Task<UInt32>> {};
+        tasks.reserve(FAN_OUT);
+        for (auto i : range(FAN_OUT)) tasks.emplace_back(onWorker(pool, i));
+
+        co_await whenAll(std::move(tasks));
+        co_return FAN_OUT;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Core.Coroutines",
+        {
+          { "Task.chain",
+              [](bench::State& state) static {
+                  state.run(CHAIN_LENGTH, [] { bench::doNotOptimize(syncWait(chain())); });
+              } },
+          { "Task.schedule",
+              [](bench::State& state) static {
+                  auto pool = ThreadPool { 1 };
+
+                  state.run(1, [&pool] { bench::doNotOptimize(syncWait(onWorker(pool, 1))); });
+              } },
+          { "Task.whenAll",
+              [](bench::State& state) static {
+                  auto pool = ThreadPool { std::max(as<Int>(std::thread::hardware_concurrency()),
+                                                    Int { 1 }) };
+
+                  state.run(FAN_OUT,
+                            [&pool] { bench::doNotOptimize(syncWait(fanOut(pool))); });
+              } },
+          { "Future.whenAll",
+              [](bench::State& state) static {
+                  auto pool    = ThreadPool { std::max(as<Int>(std::thread::hardware_concurrency()),
+                                                       Int { 1 }) };
+                  auto futures = std::vector<ThreadPool::Future<UInt32>> {};
+                  futures.reserve(FAN_OUT);
+
+                  state.run(FAN_OUT, [&pool, &futures] {
+                      for (auto i : range(FAN_OUT))
+                          futures.emplace_back(pool.postTask<UInt32>([i] { return i; }));
+                      for (auto& future : futures) bench::doNotOptimize(future.get());
+                      futures.clear();
+                  });
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,62 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto OPERATIONS_PER_THREAD = 100'000u;
+    /// one write every WRITE_PERIOD operations, like a config table read each frame
+    constexpr auto WRITE_PERIOD = 64u;
+
+    struct Config {
+        std::array<float, 8> values = {};
+    };
+
+    /// every thread reads the value, writing it from time to time
+    template<class LockedType>
+    auto contention(bench::State& state, Int thread_count) -> void {
+        auto locked = LockedType {};
+
+        state.run(OPERATIONS_PER_THREAD * as<UInt64>(thread_count), [&locked, thread_count] {
+            auto threads = std::vector<std::jthread> {};
+            threads.reserve(as<RangeExtent>(thread_count));
+            for (auto _ : range(thread_count))
+                threads.emplace_back([&locked] noexcept {
+                    auto sum = 0.f;
+                    for (auto i : range(OPERATIONS_PER_THREAD)) {
+                        if (i % WRITE_PERIOD == 0) {
+                            auto config = locked.write();
+                            config->values[i % 8] += 1.f;
+                        } else
+                            sum += locked.copy().values[i % 8];
+                    }
+                    bench::doNotOptimize(sum);
+                });
+        });
+    }
+
+    auto makeBenchmarks() -> std::vector<bench::BenchmarkFunc> {
+        auto benchmarks = std::vector<bench::BenchmarkFunc> {};
+
+        const auto add = [&benchmarks](std::string_view name, auto func) {
+            for (auto count : bench::threadCounts())
+                benchmarks.emplace_back(std::format("{}.{}", name, count),
+                                        [func, count](bench::State& state) { func(state, count); });
+        };
+        add("contention.mutex", contention<Locked<Config>>);
+        add("contention.shared_mutex", contention<SharedLocked<Config>>);
+        add("contention.spin", contention<SpinLocked<Config>>);
+        add("contention.seqlock", contention<SeqLocked<Config>>);
+
+        return benchmarks;
+    }
+
+    auto _ = bench::BenchmarkSuite { "Core.Locked", makeBenchmarks() };
+} // namespace
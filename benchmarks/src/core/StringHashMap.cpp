@@ -0,0 +1,107 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto KEY_COUNT    = 1'024u;
+    constexpr auto LOOKUP_COUNT = 100'000u;
+
+    /// module names fit in the slots, log file paths are allocated
+    auto makeKeys(bool long_keys) -> std::vector<std::string> {
+        auto keys = std::vector<std::string> {};
+        keys.reserve(KEY_COUNT);
+        for (auto i : range(KEY_COUNT))
+            keys.emplace_back(long_keys ? std::format("logs/module-{}-log.txt", i)
+                                        : std::format("module{}", i));
+
+        return keys;
+    }
+
+    template<class Map>
+    auto lookup(bench::State& state, bool long_keys) -> void {
+        const auto keys = makeKeys(long_keys);
+
+        auto map = Map {};
+        for (auto i : range(KEY_COUNT)) map[keys[i]] = i;
+
+        state.run(LOOKUP_COUNT, [&map, &keys] {
+            auto sum = UInt64 { 0 };
+            for (auto i : range(LOOKUP_COUNT)) {
+                const auto key = std::string_view { keys[i % KEY_COUNT] };
+                if (const auto it = map.find(key); it != std::ranges::end(map)) sum += it->second;
+            }
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    auto flatLookup(bench::State& state, bool long_keys) -> void {
+        const auto keys = makeKeys(long_keys);
+
+        auto map = FlatStringHashMap<UInt64> {};
+        for (auto i : range(KEY_COUNT)) map[keys[i]] = i;
+
+        state.run(LOOKUP_COUNT, [&map, &keys] {
+            auto sum = UInt64 { 0 };
+            for (auto i : range(LOOKUP_COUNT))
+                if (const auto* value = map.find(std::string_view { keys[i % KEY_COUNT] }); value)
+                    sum += *value;
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    /// the keys are hashed once, like "name"_hash constants
+    auto flatHashedLookup(bench::State& state, bool long_keys) -> void {
+        const auto keys   = makeKeys(long_keys);
+        const auto hashed = std::vector<HashedString> { std::ranges::begin(keys),
+                                                        std::ranges::end(keys) };
+
+        auto map = FlatStringHashMap<UInt64> {};
+        for (auto i : range(KEY_COUNT)) map[hashed[i]] = i;
+
+        state.run(LOOKUP_COUNT, [&map, &hashed] {
+            auto sum = UInt64 { 0 };
+            for (auto i : range(LOOKUP_COUNT))
+                if (const auto* value = map.find(hashed[i % KEY_COUNT]); value) sum += *value;
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    template<class Map>
+    auto insert(bench::State& state) -> void {
+        const auto keys = makeKeys(true);
+
+        state.run(KEY_COUNT, [&keys] {
+            auto map = Map {};
+            for (auto i : range(KEY_COUNT)) map[keys[i]] = i;
+            bench::doNotOptimize(map);
+        });
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Core.StringHashMap",
+        {
+          { "lookup.short.ankerl",
+              [](bench::State& state) static { lookup<StringHashMap<UInt64>>(state, false); } },
+          { "lookup.short.flat", [](bench::State& state) static { flatLookup(state, false); } },
+          { "lookup.short.flat.hashed",
+              [](bench::State& state) static { flatHashedLookup(state, false); } },
+          { "lookup.long.ankerl",
+              [](bench::State& state) static { lookup<StringHashMap<UInt64>>(state, true); } },
+          { "lookup.long.flat", [](bench::State& state) static { flatLookup(state, true); } },
+          { "lookup.long.flat.hashed",
+              [](bench::State& state) static { flatHashedLookup(state, true); } },
+          { "insert.ankerl",
+              [](bench::State& state) static { insert<StringHashMap<UInt64>>(state); } },
+          { "insert.flat",
+              [](bench::State& state) static { insert<FlatStringHashMap<UInt64>>(state); } },
+        }
+    };
+} // namespace
@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    /// animation -> physics -> culling -> draw list building, each node of a stage depends on
+    /// two nodes of the previous one
+    constexpr auto STAGE_COUNT = 4u;
+    constexpr auto STAGE_WIDTH = 64u;
+    constexpr auto NODE_COUNT  = STAGE_COUNT * STAGE_WIDTH;
+    constexpr auto WORK_SIZE   = 2'048u;
+
+    auto work(std::span<float> values) noexcept -> void {
+        for (auto& value : values) value = std::sqrt(value * 1.0001f + 0.5f);
+    }
+
+    auto benchmarkGraph(bench::State& state, Int thread_count) -> void {
+        auto pool   = ThreadPool { thread_count };
+        auto values = std::vector<float>(NODE_COUNT * WORK_SIZE, 1.f);
+
+        auto graph = TaskGraph {};
+        graph.reserve(NODE_COUNT, NODE_COUNT * 2);
+        for (auto node : range(NODE_COUNT))
+            graph.addTask([&values, node] {
+                work(std::span { values }.subspan(node * WORK_SIZE, WORK_SIZE));
+            });
+        for (auto stage : range(1u, STAGE_COUNT))
+            for (auto i : range(STAGE_WIDTH)) {
+                const auto previous = (stage - 1) * STAGE_WIDTH;
+                graph.addDependency(stage * STAGE_WIDTH + i, previous + i);
+                graph.addDependency(stage * STAGE_WIDTH + i,
+                                    previous + (i * 7 + 3) % STAGE_WIDTH);
+            }
+
+        state.run(NODE_COUNT, [&pool, &graph, &values] {
+            graph.run(pool);
+            bench::doNotOptimize(values);
+        });
+    }
+
+    /// same frame built with futures, each stage waits for the whole previous one
+    auto benchmarkFutures(bench::State& state, Int thread_count) -> void {
+        auto pool    = ThreadPool { thread_count };
+        auto values  = std::vector<float>(NODE_COUNT * WORK_SIZE, 1.f);
+        auto futures = std::vector<ThreadPool::Future<void>> {};
+        futures.reserve(STAGE_WIDTH);
+
+        state.run(NODE_COUNT, [&pool, &values, &futures] {
+            for (auto stage : range(STAGE_COUNT)) {
+                for (auto i : range(STAGE_WIDTH)) {
+                    const auto node = stage * STAGE_WIDTH + i;
+                    futures.emplace_back(pool.postTask<void>([&values, node] {
+                        work(std::span { values }.subspan(node * WORK_SIZE, WORK_SIZE));
+                    }));
+                }
+
+                for (auto& future : futures) future.wait();
+                futures.clear();
+            }
+            bench::doNotOptimize(values);
+        });
+    }
+
+    auto makeBenchmarks() -> std::vector<bench::BenchmarkFunc> {
+        auto benchmarks = std::vector<bench::BenchmarkFunc> {};
+
+        const auto add = [&benchmarks](std::string_view name, auto func) {
+            for (auto count : bench::threadCounts())
+                benchmarks.emplace_back(std::format("{}.{}", name, count),
+                                        [func, count](bench::State& state) { func(state, count); });
+        };
+        add("frame.graph", benchmarkGraph);
+        add("frame.futures", benchmarkFutures);
+
+        return benchmarks;
+    }
+
+    auto _ = bench::BenchmarkSuite { "Core.TaskGraph", makeBenchmarks() };
+} // namespace
@@ -0,0 +1,203 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    /// binary tree of tasks, 2^TREE_DEPTH - 1 tasks are posted
+    constexpr auto TREE_DEPTH     = 16u;
+    constexpr auto TREE_TASKS     = (1u << TREE_DEPTH) - 1u;
+    constexpr auto EXTERNAL_TASKS = 16'384u;
+    constexpr auto ITEM_COUNT     = 1u << 22;
+    constexpr auto CHUNK_SIZE     = 4'096u;
+    constexpr auto IMAGE_SIZE     = 2'048u;
+
+    /// `remaining` outlives the runs, the last task may still notify it after the wait returned
+    auto signalDone(std::atomic<UInt32>& remaining) noexcept -> void {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) remaining.notify_one();
+    }
+
+    auto waitDone(std::atomic<UInt32>& remaining) noexcept -> void {
+        for (auto value = remaining.load(std::memory_order_acquire); value != 0;
+             value      = remaining.load(std::memory_order_acquire))
+            remaining.wait(value, std::memory_order_acquire);
+    }
+
+    /// fib like recursion, one half is posted and the other half continues on the current
+    /// worker, the leaves signal their completion
+    auto spawnTree(ThreadPool& pool, std::atomic<UInt32>& remaining, UInt32 depth) -> void {
+        while (depth > 0) {
+            --depth;
+            pool.postTask<void>([&pool, &remaining, depth] { spawnTree(pool, remaining, depth); },
+                                ThreadPool::NoFuture);
+        }
+
+        signalDone(remaining);
+    }
+
+    auto benchmarkSpawnTree(bench::State& state, Int thread_count) -> void {
+        auto pool      = ThreadPool { thread_count };
+        auto remaining = std::atomic<UInt32> {};
+        state.run(TREE_TASKS, [&pool, &remaining] {
+            remaining.store(TREE_TASKS + 1, std::memory_order_relaxed);
+            spawnTree(pool, remaining, TREE_DEPTH);
+            waitDone(remaining);
+        });
+    }
+
+    auto benchmarkExternal(bench::State& state, Int thread_count) -> void {
+        auto pool      = ThreadPool { thread_count };
+        auto remaining = std::atomic<UInt32> {};
+        state.run(EXTERNAL_TASKS, [&pool, &remaining] {
+            remaining.store(EXTERNAL_TASKS, std::memory_order_relaxed);
+            for ([[maybe_unused]] auto _ : range(EXTERNAL_TASKS))
+                pool.postTask<void>([&remaining] { signalDone(remaining); }, ThreadPool::NoFuture);
+            waitDone(remaining);
+        });
+    }
+
+    auto benchmarkFuture(bench::State& state, Int thread_count) -> void {
+        auto pool    = ThreadPool { thread_count };
+        auto futures = std::vector<ThreadPool::Future<UInt32>> {};
+        futures.reserve(EXTERNAL_TASKS);
+        state.run(EXTERNAL_TASKS, [&pool, &futures] {
+            for (auto i : range(EXTERNAL_TASKS))
+                futures.emplace_back(pool.postTask<UInt32>([i] { return i; }));
+
+            auto sum = 0u;
+            for (auto& future : futures) sum += future.get();
+            futures.clear();
+
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    /// task representation used before the pooled tasks (a std::packaged_task shared with a
+    /// std::function), kept to compare the allocations and the throughput of benchmarkFuture
+    auto benchmarkPackagedTask(bench::State& state, Int thread_count) -> void {
+        auto pool    = ThreadPool { thread_count };
+        auto futures = std::vector<std::future<UInt32>> {};
+        futures.reserve(EXTERNAL_TASKS);
+        state.run(EXTERNAL_TASKS, [&pool, &futures] {
+            for (auto i : range(EXTERNAL_TASKS)) {
+                auto task = std::make_shared<std::packaged_task<UInt32()>>(
+                    std::function<UInt32()> { [i] { return i; } });
+                futures.emplace_back(task->get_future());
+                pool.postTask<void>(
+                    std::function<void()> { [task = std::move(task)] { (*task)(); } },
+                    ThreadPool::NoFuture);
+            }
+
+            auto sum = 0u;
+            for (auto& future : futures) sum += future.get();
+            futures.clear();
+
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    /// chunks posted by hand, kept to compare with parallelFor
+    auto benchmarkChunks(bench::State& state, Int thread_count) -> void {
+        auto pool      = ThreadPool { thread_count };
+        auto values    = std::vector<float>(ITEM_COUNT, 1.f);
+        auto remaining = std::atomic<UInt32> {};
+        state.run(ITEM_COUNT, [&pool, &values, &remaining] {
+            remaining.store(ITEM_COUNT / CHUNK_SIZE, std::memory_order_relaxed);
+            for (auto chunk = 0u; chunk < ITEM_COUNT; chunk += CHUNK_SIZE)
+                pool.postTask<void>(
+                    [&values, &remaining, chunk] {
+                        for (auto i : range(chunk, chunk + CHUNK_SIZE))
+                            values[i] = std::sqrt(values[i] * 1.0001f + 0.5f);
+                        signalDone(remaining);
+                    },
+                    ThreadPool::NoFuture);
+            waitDone(remaining);
+            bench::doNotOptimize(values);
+        });
+    }
+
+    /// the calling thread takes part in the parallel algorithms, the pools have one worker
+    /// less than the thread count
+    auto benchmarkParallelFor(bench::State& state, Int thread_count) -> void {
+        auto pool   = ThreadPool { thread_count - 1 };
+        auto values = std::vector<float>(ITEM_COUNT, 1.f);
+        state.run(ITEM_COUNT, [&pool, &values] {
+            parallelFor(pool, values, [](auto& value) {
+                value = std::sqrt(value * 1.0001f + 0.5f);
+            });
+            bench::doNotOptimize(values);
+        });
+    }
+
+    /// 3x3 box blur of a single channel image, one row per index
+    auto benchmarkImage(bench::State& state, Int thread_count) -> void {
+        auto pool   = ThreadPool { thread_count - 1 };
+        auto input  = std::vector<float>(IMAGE_SIZE * IMAGE_SIZE);
+        auto output = std::vector<float>(IMAGE_SIZE * IMAGE_SIZE);
+        for (auto i : range(std::size(input))) input[i] = as<float>(i % 255u);
+
+        state.run(IMAGE_SIZE * IMAGE_SIZE, [&pool, &input, &output] {
+            parallelForChunks(pool, IMAGE_SIZE - 2, [&input, &output](auto begin, auto end) {
+                for (auto y : range(begin + 1, end + 1))
+                    for (auto x : range(1u, IMAGE_SIZE - 1u)) {
+                        auto sum = 0.f;
+                        for (auto row : range(y - 1, y + 2))
+                            for (auto column : range(x - 1, x + 2))
+                                sum += input[row * IMAGE_SIZE + column];
+                        output[y * IMAGE_SIZE + x] = sum / 9.f;
+                    }
+            });
+            bench::doNotOptimize(output);
+        });
+    }
+
+    auto benchmarkParallelReduce(bench::State& state, Int thread_count) -> void {
+        auto pool   = ThreadPool { thread_count - 1 };
+        auto values = std::vector<UInt64>(ITEM_COUNT);
+        std::ranges::iota(values, UInt64 { 0 });
+        state.run(ITEM_COUNT, [&pool, &values] {
+            auto sum = parallelReduce(pool, values, UInt64 { 0 });
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    auto benchmarkParallelScan(bench::State& state, Int thread_count) -> void {
+        auto pool   = ThreadPool { thread_count - 1 };
+        auto values = std::vector<UInt64>(ITEM_COUNT, 1);
+        auto output = std::vector<UInt64>(ITEM_COUNT);
+        state.run(ITEM_COUNT, [&pool, &values, &output] {
+            parallelScan(pool, values, output);
+            bench::doNotOptimize(output);
+        });
+    }
+
+    auto makeBenchmarks() -> std::vector<bench::BenchmarkFunc> {
+        auto benchmarks = std::vector<bench::BenchmarkFunc> {};
+
+        const auto add = [&benchmarks](std::string_view name, auto func) {
+            for (auto count : bench::threadCounts())
+                benchmarks.emplace_back(std::format("{}.{}", name, count),
+                                        [func, count](bench::State& state) { func(state, count); });
+        };
+        add("spawnTree", benchmarkSpawnTree);
+        add("postTask.external", benchmarkExternal);
+        add("postTask.future", benchmarkFuture);
+        add("postTask.packagedTask", benchmarkPackagedTask);
+        add("postTask.chunks", benchmarkChunks);
+        add("parallelFor", benchmarkParallelFor);
+        add("parallelFor.image", benchmarkImage);
+        add("parallelReduce", benchmarkParallelReduce);
+        add("parallelScan", benchmarkParallelScan);
+
+        return benchmarks;
+    }
+
+    auto _ = bench::BenchmarkSuite { "Core.ThreadPool", makeBenchmarks() };
+} // namespace
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto NODE_COUNT = 100'000u;
+    constexpr auto SEED       = 0x5EEDu;
+
+    using IndexType = TreeNode::IndexType;
+
+    /// Scene graph with a single root, the parent of each node is picked randomly among the
+    /// previous ones so the depth first order is scattered in memory
+    auto makeTree() -> std::pair<Tree<>, IndexType> {
+        auto tree = Tree<> {};
+        auto root = tree.insert(TreeNode {}, TreeNode::INVALID_INDEX, TreeNode::INVALID_INDEX);
+
+        auto generator = std::mt19937 { SEED };
+        auto nodes     = std::vector<IndexType> { root };
+        nodes.reserve(NODE_COUNT);
+        for (auto _ : range(NODE_COUNT - 1u)) {
+            const auto parent = nodes[std::uniform_int_distribution<RangeExtent> {
+                0,
+                std::size(nodes) - 1u }(generator)];
+            nodes.emplace_back(tree.insert(TreeNode {}, parent, TreeNode::INVALID_INDEX));
+        }
+
+        return { std::move(tree), root };
+    }
+
+    auto depthFirst(bench::State& state, bool compacted) -> void {
+        auto [tree, root] = makeTree();
+        if (compacted) root = tree.compact()[root];
+
+        state.run(NODE_COUNT, [&tree, root] {
+            auto sum = UInt32 { 0 };
+            for (auto index : tree.depthFirst(root)) sum += tree[index].dirtyBits();
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    auto propagateDirties(bench::State& state, Int thread_count) -> void {
+        auto [tree, root] = makeTree();
+        auto pool         = ThreadPool { thread_count };
+
+        state.run(NODE_COUNT, [&tree, &pool, root, thread_count] {
+            tree.clearDirties();
+            tree.markDirty(root, 1);
+            if (thread_count > 0)
+                tree.propagateDirties(pool);
+            else
+                tree.propagateDirties();
+            bench::doNotOptimize(tree.dirties());
+        });
+    }
+
+    auto makeBenchmarks() -> std::vector<bench::BenchmarkFunc> {
+        auto benchmarks = std::vector<bench::BenchmarkFunc> {
+            { "depthFirst.scattered", [](bench::State& state) { depthFirst(state, false); } },
+            { "depthFirst.compacted", [](bench::State& state) { depthFirst(state, true); } },
+            { "breadthFirst",
+             [](bench::State& state) {
+                  const auto [tree, root] = makeTree();
+
+                  state.run(NODE_COUNT, [&tree, root] {
+                      auto sum = UInt32 { 0 };
+                      for (auto index : tree.breadthFirst(root)) sum += tree[index].dirtyBits();
+                      bench::doNotOptimize(sum);
+                  });
+              } },
+        };
+
+        // 0 propagates without a pool
+        auto counts = bench::threadCounts();
+        counts.insert(std::ranges::begin(counts), 0);
+        for (auto count : counts)
+            benchmarks.emplace_back(std::format("propagateDirties.{}", count),
+                                    [count](bench::State& state) {
+                                        propagateDirties(state, count);
+                                    });
+
+        return benchmarks;
+    }
+
+    auto _ = bench::BenchmarkSuite { "Core.Tree", makeBenchmarks() };
+} // namespace
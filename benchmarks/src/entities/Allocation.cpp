@@ -0,0 +1,139 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 100'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+    };
+
+    struct VelocityComponent: entities::Component {
+        static constexpr Type TYPE = "VelocityComponent"_component_type;
+
+        float x = 1.f;
+        float y = 2.f;
+        float z = 3.f;
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        return std::make_unique<entities::EntityManager>(entities::ExecutionMode::Deterministic);
+    }
+
+    auto spawn(entities::EntityManager& world) -> void {
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+            const auto e = world.makeEntity();
+            world.addComponent<PositionComponent>(e);
+            world.addComponent<VelocityComponent>(e);
+        }
+        world.step(Secondf { 0 });
+    }
+
+    auto integrate(entities::EntityManager& world) -> void {
+        world.view<PositionComponent, const VelocityComponent>().each(
+            [](entities::Entity, auto& position, const auto& velocity) noexcept {
+                position.x += velocity.x;
+                position.y += velocity.y;
+                position.z += velocity.z;
+            });
+    }
+
+    /// Destroy and respawn a random half of the entities `rounds` times, so the slots are
+    /// recycled out of order
+    auto churn(entities::EntityManager& world, UInt32 rounds) -> void {
+        auto generator = std::mt19937 { 42 };
+        for ([[maybe_unused]] auto _ : range(rounds)) {
+            for (auto e : world.entities())
+                if (generator() % 2 == 0) world.destroyEntity(e);
+            world.step(Secondf { 0 });
+
+            for ([[maybe_unused]] auto _ : range(ENTITY_COUNT - world.entityCount())) {
+                const auto e = world.makeEntity();
+                world.addComponent<PositionComponent>(e);
+                world.addComponent<VelocityComponent>(e);
+            }
+            world.step(Secondf { 0 });
+        }
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Allocation",
+        {
+          { "spawn",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      spawn(*world);
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "spawn.reserved",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] {
+                          auto world = makeWorld();
+                          world->reserveEntities(ENTITY_COUNT);
+                          world->componentPool<PositionComponent>().reserve(ENTITY_COUNT);
+                          world->componentPool<VelocityComponent>().reserve(ENTITY_COUNT);
+                          return world;
+                      },
+                      [](auto& world) {
+                          spawn(*world);
+                          bench::doNotOptimize(*world);
+                      });
+              } },
+          { "destroyAll.respawn",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT * 2,
+                      [] {
+                          auto world = makeWorld();
+                          spawn(*world);
+                          return world;
+                      },
+                      [](auto& world) {
+                          world->destroyAllEntities();
+                          world->step(Secondf { 0 });
+                          spawn(*world);
+                          bench::doNotOptimize(*world);
+                      });
+              } },
+          // packed pools keep the iteration linear whatever the spawn history, compare the
+          // two to see the cost of the scattered slot indices after churn
+          { "iterate.fresh",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  spawn(*world);
+                  state.run(ENTITY_COUNT, [&world] {
+                      integrate(*world);
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "iterate.churned",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  spawn(*world);
+                  churn(*world, 8);
+                  state.run(ENTITY_COUNT, [&world] {
+                      integrate(*world);
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
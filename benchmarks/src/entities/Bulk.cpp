@@ -0,0 +1,105 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 1'000'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+    };
+
+    struct VelocityComponent: entities::Component {
+        static constexpr Type TYPE = "VelocityComponent"_component_type;
+
+        float x = 1.f;
+        float y = 2.f;
+        float z = 3.f;
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        return std::make_unique<entities::EntityManager>(entities::ExecutionMode::Deterministic);
+    }
+
+    auto makePopulatedWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = makeWorld();
+        world->makeEntities(ENTITY_COUNT, PositionComponent {}, VelocityComponent {});
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Bulk",
+        {
+          { "spawn.loop",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+                          const auto e = world->makeEntity();
+                          world->template addComponent<PositionComponent>(e);
+                          world->template addComponent<VelocityComponent>(e);
+                      }
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "spawn.makeEntities",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      world->makeEntities(ENTITY_COUNT, PositionComponent {}, VelocityComponent {});
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "spawn.makeEntities.spans",
+              [](bench::State& state) {
+                  const auto positions  = std::vector<PositionComponent>(ENTITY_COUNT);
+                  const auto velocities = std::vector<VelocityComponent>(ENTITY_COUNT);
+                  state.run(ENTITY_COUNT, makeWorld, [&positions, &velocities](auto& world) {
+                      world->makeEntities(std::span<const PositionComponent> { positions },
+                                          std::span<const VelocityComponent> { velocities });
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "destroy.loop",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT / 2, makePopulatedWorld, [](auto& world) {
+                      const auto& entities = world->entities();
+                      for (auto i = 0u; i < std::size(entities); i += 2)
+                          world->destroyEntity(entities[i]);
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "destroy.destroyEntities",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT / 2, makePopulatedWorld, [](auto& world) {
+                      // clang-format off
+                      const auto half = world->entities()
+                                        | std::views::stride(2)
+                                        | std::ranges::to<std::vector>();
+                      // clang-format on
+                      world->destroyEntities(half);
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
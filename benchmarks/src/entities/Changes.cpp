@@ -0,0 +1,87 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 100'000u;
+    /// one entity out of CHANGED_STRIDE is modified each frame (5%)
+    constexpr auto CHANGED_STRIDE = 20u;
+
+    struct SpriteComponent: entities::Component {
+        static constexpr Type TYPE = "SpriteComponent"_component_type;
+
+        std::array<float, 16> vertices = {};
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT))
+            world->addComponent<SpriteComponent>(world->makeEntity());
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    /// Touch 5% of the sprites then start a new frame, `since` is the frame of the touch
+    auto touch(entities::EntityManager& world) -> entities::Tick {
+        const auto since = world.tick();
+
+        const auto& entities = world.entities();
+        for (auto i = 0u; i < std::size(entities); i += CHANGED_STRIDE)
+            world.getComponent<SpriteComponent>(entities[i]).vertices[0] += 1.f;
+        world.step(Secondf { 0 });
+
+        return since;
+    }
+
+    auto upload(std::vector<float>& buffer, const SpriteComponent& component) -> void {
+        buffer.insert(std::end(buffer), std::begin(component.vertices), std::end(component.vertices));
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Changes",
+        {
+          { "upload.all",
+              [](bench::State& state) {
+                  auto world  = makeWorld();
+                  auto buffer = std::vector<float> {};
+                  state.run(ENTITY_COUNT, [&world, &buffer] {
+                      touch(*world);
+
+                      buffer.clear();
+                      std::as_const(*world).view<SpriteComponent>().each(
+                          [&buffer](entities::Entity, const auto& component) {
+                              upload(buffer, component);
+                          });
+                      bench::doNotOptimize(buffer);
+                  });
+              } },
+          { "upload.changed",
+              [](bench::State& state) {
+                  auto world  = makeWorld();
+                  auto buffer = std::vector<float> {};
+                  state.run(ENTITY_COUNT, [&world, &buffer] {
+                      const auto since = touch(*world);
+
+                      buffer.clear();
+                      std::as_const(*world).changed<SpriteComponent>(since).each(
+                          [&buffer](entities::Entity, const auto& component) {
+                              upload(buffer, component);
+                          });
+                      bench::doNotOptimize(buffer);
+                  });
+              } },
+          }
+    };
+} // namespace
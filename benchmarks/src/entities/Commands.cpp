@@ -0,0 +1,82 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 100'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+    };
+
+    struct TagComponent: entities::Component {
+        static constexpr Type TYPE = "TagComponent"_component_type;
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>();
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT))
+            world->addComponent<PositionComponent>(world->makeEntity());
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Commands",
+        {
+          { "addComponent.immediate",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      for (auto e : world->entities()) world->template addComponent<TagComponent>(e);
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "addComponent.deferred",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      auto& commands = world->commands();
+                      for (auto e : world->entities()) commands.template addComponent<TagComponent>(e);
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "addComponent.deferred.parallel",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      world->template parallelEach<const PositionComponent>(
+                          [&commands = world->commands()](entities::Entity e, const auto&) {
+                              commands.template addComponent<TagComponent>(e);
+                          });
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "makeEntity.deferred.parallel",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      world->template parallelEach<const PositionComponent>(
+                          [&commands = world->commands()](entities::Entity, const auto&) {
+                              commands.template addComponent<PositionComponent>(commands.makeEntity());
+                          });
+                      world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
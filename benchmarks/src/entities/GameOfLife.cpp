@@ -0,0 +1,119 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto BOARD_SIZE       = 256u;
+    constexpr auto CELL_COUNT       = BOARD_SIZE * BOARD_SIZE;
+    constexpr auto GENERATION_COUNT = 16u;
+    constexpr auto SEED             = 0x5EEDu;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        UInt32 x;
+        UInt32 y;
+    };
+
+    auto positionOf(UInt32 cell) noexcept -> PositionComponent {
+        auto position = PositionComponent {};
+        position.x    = cell % BOARD_SIZE;
+        position.y    = cell / BOARD_SIZE;
+
+        return position;
+    }
+
+    /// Workload of examples/entities/gameoflife: one entity per alive cell, each generation
+    /// counts the neighbours from the PositionComponent view then creates and destroys (through
+    /// the command buffer) the entities of the cells whose state changed, the example's O(n²)
+    /// cell lookup is replaced by a grid so the ECS dominates the timings
+    class GameOfLifeSystem final: public entities::System {
+      public:
+        explicit GameOfLifeSystem(entities::EntityManager& manager)
+            : System { manager, 0, { PositionComponent::TYPE } } {
+            m_cells.resize(CELL_COUNT);
+        }
+
+        auto update(Secondf) -> void override {
+            std::ranges::fill(m_cells, Cell {});
+
+            for (auto&& [e, position] : m_manager->view<const PositionComponent>()) {
+                m_cells[position.x + BOARD_SIZE * position.y].e = e;
+
+                for (auto dy : { -1, 0, 1 })
+                    for (auto dx : { -1, 0, 1 }) {
+                        if (dx == 0 and dy == 0) continue;
+
+                        const auto x = position.x + static_cast<UInt32>(dx);
+                        const auto y = position.y + static_cast<UInt32>(dy);
+                        if (x < BOARD_SIZE and y < BOARD_SIZE)
+                            m_cells[x + BOARD_SIZE * y].adjacent_alive_cells += 1;
+                    }
+            }
+
+            auto& commands = m_manager->commands();
+            for (auto i : range(CELL_COUNT)) {
+                const auto& cell      = m_cells[i];
+                const auto  was_alive = cell.e != entities::INVALID_ENTITY;
+                const auto  alive     = cell.adjacent_alive_cells == 3
+                                   or (was_alive and cell.adjacent_alive_cells == 2);
+
+                if (alive and not was_alive)
+                    commands.addComponent<PositionComponent>(commands.makeEntity(), positionOf(i));
+                else if (not alive and was_alive)
+                    commands.destroyEntity(cell.e);
+            }
+        }
+
+      protected:
+        auto onMessageReceived(const entities::Message&) -> void override {}
+
+      private:
+        struct Cell {
+            entities::Entity e                    = entities::INVALID_ENTITY;
+            UInt32           adjacent_alive_cells = 0;
+        };
+
+        std::vector<Cell> m_cells;
+    };
+
+    /// About a third of the cells start alive, picked with a fixed seed
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+        world->addSystem<GameOfLifeSystem>();
+
+        auto generator    = std::mt19937 { SEED };
+        auto distribution = std::bernoulli_distribution { 1. / 3. };
+        for (auto i : range(CELL_COUNT))
+            if (distribution(generator))
+                world->addComponent<PositionComponent>(world->makeEntity(), positionOf(i));
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.GameOfLife",
+        {
+          { "step",
+              [](bench::State& state) {
+                  state.run(CELL_COUNT * GENERATION_COUNT, makeWorld, [](auto& world) {
+                      for ([[maybe_unused]] auto _ : range(GENERATION_COUNT))
+                          world->step(Secondf { 0 });
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto ENTITY_COUNT         = 100'000u;
+    constexpr auto COMPONENT_TYPE_COUNT = 8u;
+    constexpr auto SEED                 = 0x5EEDu;
+
+    template<UInt32 N>
+    struct DataComponent: entities::Component {
+        static constexpr Type TYPE = entities::componentHash("DataComponent") + N;
+
+        UInt32 value = N;
+    };
+
+    /// Every entity has the COMPONENT_TYPE_COUNT component types
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+
+        [&world]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+            world->makeEntities(ENTITY_COUNT, DataComponent<Ns> {}...);
+        }(std::make_integer_sequence<UInt32, COMPONENT_TYPE_COUNT> {});
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    /// Iterate over the entities with the first `COUNT` component types, accumulating the
+    /// read-only ones into the first one
+    template<UInt32 COUNT>
+    auto benchmarkIteration(bench::State& state) -> void {
+        auto world = makeWorld();
+        state.run(ENTITY_COUNT, [&world] {
+            [&world]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+                world->view<DataComponent<0>, const DataComponent<Ns + 1>...>().each(
+                    [](entities::Entity, auto& first, const auto&... others) noexcept {
+                        first.value += (0u + ... + others.value);
+                    });
+            }(std::make_integer_sequence<UInt32, COUNT - 1> {});
+            bench::doNotOptimize(*world);
+        });
+    }
+
+    /// Read one component of every entity, in creation order or shuffled with a fixed seed
+    auto benchmarkAccess(bench::State& state, bool shuffled) -> void {
+        auto world = makeWorld();
+
+        auto order = world->entities();
+        if (shuffled) std::ranges::shuffle(order, std::mt19937 { SEED });
+
+        state.run(ENTITY_COUNT, [&world, &order] {
+            auto sum = 0u;
+            for (auto e : order) sum += std::as_const(*world).getComponent<DataComponent<3>>(e).value;
+            bench::doNotOptimize(sum);
+        });
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Iteration",
+        {
+          { "view.1", benchmarkIteration<1> },
+          { "view.2", benchmarkIteration<2> },
+          { "view.4", benchmarkIteration<4> },
+          { "view.8", benchmarkIteration<8> },
+          { "getComponent.sequential", [](bench::State& state) { benchmarkAccess(state, false); } },
+          { "getComponent.random", [](bench::State& state) { benchmarkAccess(state, true); } },
+          }
+    };
+} // namespace
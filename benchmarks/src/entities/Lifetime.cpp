@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 50'000u;
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Lifetime",
+        {
+          { "create",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] { return entities::EntityManager {}; },
+                      [](entities::EntityManager& world) {
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world.makeEntity();
+                          world.step(Secondf { 0 });
+                          bench::doNotOptimize(world);
+                      });
+              } },
+          { "hasEntity",
+              [](bench::State& state) {
+                  auto world = entities::EntityManager {};
+                  for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world.makeEntity();
+                  world.step(Secondf { 0 });
+
+                  state.run(ENTITY_COUNT, [&world] {
+                      auto alive = 0u;
+                      for (auto e : world.entities())
+                          if (world.hasEntity(e)) ++alive;
+                      bench::doNotOptimize(alive);
+                  });
+              } },
+          { "destroy.recycle",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT * 2,
+                      [] {
+                          auto world = entities::EntityManager {};
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world.makeEntity();
+                          world.step(Secondf { 0 });
+                          return world;
+                      },
+                      [](entities::EntityManager& world) {
+                          for (auto e : world.entities()) world.destroyEntity(e);
+                          world.step(Secondf { 0 });
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world.makeEntity();
+                          world.step(Secondf { 0 });
+                          bench::doNotOptimize(world);
+                      });
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto ENTITY_COUNT         = 10'000u;
+    constexpr auto SYSTEM_COUNT         = 32u;
+    constexpr auto COMPONENT_TYPE_COUNT = 8u;
+
+    template<UInt32 N>
+    struct DataComponent: entities::Component {
+        static constexpr Type TYPE = entities::componentHash("DataComponent") + N;
+
+        UInt32 value = N;
+    };
+
+    /// Each system requires two of the component types, the toggled one is used by a quarter of
+    /// them
+    template<UInt32 N>
+    class MatchSystem final: public entities::System {
+      public:
+        explicit MatchSystem(entities::EntityManager& manager)
+            : System { manager,
+                       N,
+                       { DataComponent<N % COMPONENT_TYPE_COUNT>::TYPE,
+                         DataComponent<(N + 1) % COMPONENT_TYPE_COUNT>::TYPE } } {}
+
+        auto update(Secondf) -> void override {}
+
+      protected:
+        auto onMessageReceived(const entities::Message&) -> void override {}
+    };
+
+    using ToggledComponent = DataComponent<COMPONENT_TYPE_COUNT - 1>;
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+
+        [&world]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+            for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+                const auto e = world->makeEntity();
+                (world->addComponent<DataComponent<Ns>>(e), ...);
+            }
+        }(std::make_integer_sequence<UInt32, COMPONENT_TYPE_COUNT> {});
+
+        [&world]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+            (world->addSystem<MatchSystem<Ns>>(), ...);
+        }(std::make_integer_sequence<UInt32, SYSTEM_COUNT> {});
+
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Membership",
+        {
+          { "toggleComponent.step",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  state.run(ENTITY_COUNT * 2, [&world] {
+                      for (auto e : world->entities()) world->destroyComponent<ToggledComponent>(e);
+                      world->step(Secondf { 0 });
+
+                      for (auto e : world->entities()) world->addComponent<ToggledComponent>(e);
+                      world->step(Secondf { 0 });
+
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "addSystem",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      world->template addSystem<MatchSystem<SYSTEM_COUNT>>();
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,107 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 10'000u;
+    constexpr auto SYSTEM_COUNT = 32u;
+
+    template<UInt32 N>
+    class ListenerSystem final: public entities::System {
+      public:
+        ListenerSystem(bool subscribed, entities::EntityManager& manager)
+            : System { manager, N, {} } {
+            if (subscribed) subscribe({ entities::EntityManager::ADDED_ENTITY_MESSAGE_ID });
+            else
+                subscribe({});
+        }
+
+        auto update(Secondf) -> void override {}
+
+      protected:
+        auto onMessageReceived(const entities::Message& message) -> void override {
+            m_received += std::size(message.entities);
+        }
+
+      private:
+        RangeExtent m_received = 0;
+    };
+
+    /// Mirror of the previous MessageBus (one message and one vector per entity) used as a
+    /// baseline
+    struct LegacyMessage {
+        UInt32                        id;
+        std::vector<entities::Entity> entities;
+    };
+
+    /// `subscribed_systems` out of SYSTEM_COUNT systems are interested in the ADDED messages
+    auto makeWorld(UInt32 subscribed_systems) -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+
+        [&]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+            (world->addSystem<ListenerSystem<Ns>>(Ns < subscribed_systems), ...);
+        }(std::make_integer_sequence<UInt32, SYSTEM_COUNT> {});
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Messages",
+        {
+          { "push.legacy",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, [] {
+                      auto queue = std::queue<LegacyMessage> {};
+                      for (auto i : range(ENTITY_COUNT))
+                          queue.push(LegacyMessage {
+                              entities::EntityManager::ADDED_ENTITY_MESSAGE_ID,
+                              { as<entities::Entity>(i + 1) } });
+                      bench::doNotOptimize(queue);
+                  });
+              } },
+          { "push.batched",
+              [](bench::State& state) {
+                  auto bus = entities::MessageBus {};
+                  state.run(ENTITY_COUNT, [&bus] {
+                      for (auto i : range(ENTITY_COUNT))
+                          bus.push(entities::EntityManager::ADDED_ENTITY_MESSAGE_ID,
+                                   as<entities::Entity>(i + 1));
+                      bench::doNotOptimize(bus);
+                      bus.clear();
+                  });
+              } },
+          { "spawn.step.all_subscribed",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] { return makeWorld(SYSTEM_COUNT); },
+                      [](auto& world) {
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world->makeEntity();
+                          world->step(Secondf { 0 });
+                          bench::doNotOptimize(*world);
+                      });
+              } },
+          { "spawn.step.quarter_subscribed",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] { return makeWorld(SYSTEM_COUNT / 4); },
+                      [](auto& world) {
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) world->makeEntity();
+                          world->step(Secondf { 0 });
+                          bench::doNotOptimize(*world);
+                      });
+              } },
+          }
+    };
+} // namespace
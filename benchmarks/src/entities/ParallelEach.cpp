@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 1'000'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+    };
+
+    struct VelocityComponent: entities::Component {
+        static constexpr Type TYPE = "VelocityComponent"_component_type;
+
+        float x = 1.f;
+        float y = 2.f;
+        float z = 3.f;
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+            const auto e = world->makeEntity();
+            world->addComponent<PositionComponent>(e);
+            world->addComponent<VelocityComponent>(e);
+        }
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto integrate(entities::Entity, PositionComponent& position, const VelocityComponent& velocity)
+        noexcept -> void {
+        constexpr auto DELTA = 0.016f;
+
+        position.x = std::fma(velocity.x, DELTA, position.x);
+        position.y = std::fma(velocity.y, DELTA, position.y);
+        position.z = std::fma(velocity.z, DELTA, position.z);
+    }
+
+    /// `thread_count` counts the calling thread, which process chunks too
+    auto benchmarkThreads(bench::State& state, Int thread_count) -> void {
+        auto world = makeWorld();
+        auto pool  = ThreadPool { thread_count - 1 };
+        state.run(ENTITY_COUNT, [&world, &pool] {
+            world->view<PositionComponent, const VelocityComponent>().parallelEach(pool, integrate);
+            bench::doNotOptimize(*world);
+        });
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.ParallelEach",
+        {
+          { "each",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  state.run(ENTITY_COUNT, [&world] {
+                      world->view<PositionComponent, const VelocityComponent>().each(integrate);
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "parallelEach.1", [](bench::State& state) { benchmarkThreads(state, 1); } },
+          { "parallelEach.2", [](bench::State& state) { benchmarkThreads(state, 2); } },
+          { "parallelEach.4", [](bench::State& state) { benchmarkThreads(state, 4); } },
+          { "parallelEach.8", [](bench::State& state) { benchmarkThreads(state, 8); } },
+          }
+    };
+} // namespace
@@ -0,0 +1,109 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+
+namespace {
+    constexpr auto ENTITY_COUNT    = 4'096u;
+    constexpr auto SYSTEM_COUNT    = 32u;
+    constexpr auto WORK_PER_ENTITY = 16u;
+
+    struct SharedComponent: entities::Component {
+        static constexpr Type TYPE = entities::componentHash("SharedComponent");
+
+        float value = 0.5f;
+    };
+
+    template<UInt32 N>
+    struct DataComponent: entities::Component {
+        static constexpr Type TYPE = entities::componentHash("DataComponent") + N;
+
+        float value = 1.f;
+    };
+
+    /// Synthetic system doing some floating point work on its own component, `Conflicting`
+    /// systems all write the shared component so they can't run concurrently.
+    template<UInt32 N, bool Conflicting>
+    class WorkSystem final: public entities::System {
+      public:
+        explicit WorkSystem(entities::EntityManager& manager)
+            : System { manager,
+                       N,
+                       { SharedComponent::TYPE },
+                       Conflicting ? ComponentTypes { DataComponent<N>::TYPE, SharedComponent::TYPE }
+                                   : ComponentTypes { DataComponent<N>::TYPE } },
+              m_world { &manager } {}
+
+        auto update(Secondf) -> void override {
+            m_world->view<DataComponent<N>, const SharedComponent>().each(
+                [](entities::Entity, auto& data, const auto& shared) static noexcept {
+                    for ([[maybe_unused]] auto _ : range(WORK_PER_ENTITY))
+                        data.value = std::sin(data.value + shared.value);
+                });
+        }
+
+      protected:
+        auto onMessageReceived(const entities::Message&) -> void override {}
+
+      private:
+        entities::EntityManager* m_world;
+    };
+
+    template<bool Conflicting>
+    auto makeWorld(entities::ExecutionMode mode) -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(mode);
+
+        [&world]<UInt32... Ns>(std::integer_sequence<UInt32, Ns...>) {
+            for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+                const auto e = world->makeEntity();
+                world->addComponent<SharedComponent>(e);
+                (world->addComponent<DataComponent<Ns>>(e), ...);
+            }
+
+            (world->addSystem<WorkSystem<Ns, Conflicting>>(), ...);
+        }(std::make_integer_sequence<UInt32, SYSTEM_COUNT> {});
+
+        world->step(Secondf { 0 });
+
+        return world;
+    }
+
+    template<bool Conflicting>
+    auto benchmarkStep(bench::State& state, entities::ExecutionMode mode) -> void {
+        auto world = makeWorld<Conflicting>(mode);
+        state.run(ENTITY_COUNT * SYSTEM_COUNT, [&world] {
+            world->step(Secondf { 0.016f });
+            bench::doNotOptimize(*world);
+        });
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Scheduler",
+        {
+          { "step.independent.deterministic",
+              [](bench::State& state) {
+                  benchmarkStep<false>(state, entities::ExecutionMode::Deterministic);
+              } },
+          { "step.independent.parallel",
+              [](bench::State& state) {
+                  benchmarkStep<false>(state, entities::ExecutionMode::Parallel);
+              } },
+          { "step.conflicting.deterministic",
+              [](bench::State& state) {
+                  benchmarkStep<true>(state, entities::ExecutionMode::Deterministic);
+              } },
+          { "step.conflicting.parallel",
+              [](bench::State& state) {
+                  benchmarkStep<true>(state, entities::ExecutionMode::Parallel);
+              } },
+          }
+    };
+} // namespace
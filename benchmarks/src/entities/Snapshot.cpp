@@ -0,0 +1,107 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 1'000'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+        float z = 0.f;
+    };
+
+    struct VelocityComponent: entities::Component {
+        static constexpr Type TYPE = "VelocityComponent"_component_type;
+
+        float x = 1.f;
+        float y = 2.f;
+        float z = 3.f;
+    };
+
+    auto makeWorld() -> std::unique_ptr<entities::EntityManager> {
+        auto world = std::make_unique<entities::EntityManager>(
+            entities::ExecutionMode::Deterministic);
+        world->registerComponent<PositionComponent>();
+        world->registerComponent<VelocityComponent>();
+
+        return world;
+    }
+
+    auto populate(entities::EntityManager& world) -> void {
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+            const auto e = world.makeEntity();
+            world.addComponent<PositionComponent>(e);
+            world.addComponent<VelocityComponent>(e);
+        }
+        world.step(Secondf { 0 });
+    }
+
+    auto snapshotPath() -> std::filesystem::path {
+        return std::filesystem::temp_directory_path() / "stormkit-entities-bench.snapshot";
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Snapshot",
+        {
+          { "rebuild",
+              [](bench::State& state) {
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      populate(*world);
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "save",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  populate(*world);
+                  state.run(ENTITY_COUNT, [&world] {
+                      const auto result = world->saveSnapshot(snapshotPath());
+                      ensures(result.has_value());
+                  });
+              } },
+          { "load",
+              [](bench::State& state) {
+                  {
+                      auto world = makeWorld();
+                      populate(*world);
+                      ensures(world->saveSnapshot(snapshotPath()).has_value());
+                  }
+
+                  state.run(ENTITY_COUNT, makeWorld, [](auto& world) {
+                      const auto result = world->loadSnapshot(snapshotPath());
+                      ensures(result.has_value());
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          { "roundtrip.memory",
+              [](bench::State& state) {
+                  auto world = makeWorld();
+                  populate(*world);
+                  state.run(ENTITY_COUNT, [&world] {
+                      auto stream = std::stringstream {};
+                      ensures(world->saveSnapshot(stream).has_value());
+
+                      // copy into an aligned buffer, as a rollback buffer would be
+                      const auto view   = stream.view();
+                      auto       buffer = std::vector<Byte>(std::size(view));
+                      std::memcpy(std::data(buffer), std::data(view), std::size(view));
+                      ensures(world->loadSnapshot(buffer).has_value());
+                      bench::doNotOptimize(*world);
+                  });
+              } },
+          }
+    };
+} // namespace
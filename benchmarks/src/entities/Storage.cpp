@@ -0,0 +1,210 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Bench;
+
+using namespace stormkit;
+using namespace stormkit::entities::literals;
+
+namespace {
+    constexpr auto ENTITY_COUNT = 100'000u;
+
+    struct PositionComponent: entities::Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+    };
+
+    struct VelocityComponent: entities::Component {
+        static constexpr Type TYPE = "VelocityComponent"_component_type;
+
+        float x = 1.f;
+        float y = 1.f;
+    };
+
+    /// Mirror of the previous EntityManager storage (one heap allocated component per
+    /// (entity, type) key in a hash map) used as a baseline.
+    class MapStorage {
+      public:
+        template<entities::meta::IsComponentType T>
+        auto add(entities::Entity entity) -> T& {
+            auto& component = m_components[keyFor(entity, T::TYPE)];
+            component       = std::make_unique<T>();
+            m_registered_components_for_entities[entity].emplace_back(T::TYPE);
+
+            return static_cast<T&>(*component);
+        }
+
+        template<entities::meta::IsComponentType T>
+        auto remove(entities::Entity entity) -> void {
+            m_components.erase(keyFor(entity, T::TYPE));
+            std::erase(m_registered_components_for_entities[entity], T::TYPE);
+        }
+
+        template<entities::meta::IsComponentType T>
+        auto get(entities::Entity entity) -> T& {
+            return static_cast<T&>(*m_components.at(keyFor(entity, T::TYPE)));
+        }
+
+        auto entities() const noexcept -> const std::vector<entities::Entity>& {
+            return m_entities;
+        }
+
+        auto makeEntity() -> entities::Entity {
+            return m_entities.emplace_back(as<entities::Entity>(std::size(m_entities) + 1));
+        }
+
+      private:
+        static constexpr auto keyFor(entities::Entity e, entities::Component::Type type) noexcept
+            -> UInt64 {
+            return (static_cast<UInt64>(e) << 32) | static_cast<UInt64>(type);
+        }
+
+        using ComponentTypes = std::vector<entities::Component::Type>;
+
+        std::vector<entities::Entity>                         m_entities;
+        HashMap<entities::Entity, ComponentTypes>             m_registered_components_for_entities;
+        HashMap<UInt64, std::unique_ptr<entities::Component>> m_components;
+    };
+
+    auto makeMapStorage() -> MapStorage {
+        auto storage = MapStorage {};
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+            const auto e = storage.makeEntity();
+            storage.add<PositionComponent>(e);
+            storage.add<VelocityComponent>(e);
+        }
+
+        return storage;
+    }
+
+    auto makeWorld(bool with_components) -> entities::EntityManager {
+        auto world = entities::EntityManager {};
+        for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) {
+            const auto e = world.makeEntity();
+            if (with_components) {
+                world.addComponent<PositionComponent>(e);
+                world.addComponent<VelocityComponent>(e);
+            }
+        }
+        world.step(Secondf { 0 });
+
+        return world;
+    }
+
+    auto _ = bench::BenchmarkSuite {
+        "Entities.Storage",
+        {
+          { "iterate.map",
+              [](bench::State& state) {
+                  auto storage = makeMapStorage();
+                  state.run(ENTITY_COUNT, [&storage] {
+                      for (auto e : storage.entities()) {
+                          auto&       position = storage.get<PositionComponent>(e);
+                          const auto& velocity = storage.get<VelocityComponent>(e);
+                          position.x += velocity.x;
+                          position.y += velocity.y;
+                      }
+                      bench::doNotOptimize(storage);
+                  });
+              } },
+          { "iterate.pool",
+              [](bench::State& state) {
+                  auto world = makeWorld(true);
+                  state.run(ENTITY_COUNT, [&world] {
+                      auto&       positions  = world.componentPool<PositionComponent>();
+                      const auto& velocities = world.componentPool<VelocityComponent>();
+                      for (auto&& [e, position] :
+                           std::views::zip(positions.entities(), positions.components())) {
+                          const auto& velocity = velocities.get(e);
+                          position.x += velocity.x;
+                          position.y += velocity.y;
+                      }
+                      bench::doNotOptimize(world);
+                  });
+              } },
+          { "iterate.view",
+              [](bench::State& state) {
+                  auto world = makeWorld(true);
+                  state.run(ENTITY_COUNT, [&world] {
+                      for (auto&& [_, position, velocity] :
+                           world.view<PositionComponent, const VelocityComponent>()) {
+                          position.x += velocity.x;
+                          position.y += velocity.y;
+                      }
+                      bench::doNotOptimize(world);
+                  });
+              } },
+          { "iterate.view.each",
+              [](bench::State& state) {
+                  auto world = makeWorld(true);
+                  state.run(ENTITY_COUNT, [&world] {
+                      world.view<PositionComponent, const VelocityComponent>().each(
+                          [](entities::Entity, auto& position, const auto& velocity) static noexcept {
+                              position.x += velocity.x;
+                              position.y += velocity.y;
+                          });
+                      bench::doNotOptimize(world);
+                  });
+              } },
+          { "add.map",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT * 2,
+                      [] {
+                          auto storage = MapStorage {};
+                          for ([[maybe_unused]] auto _ : range(ENTITY_COUNT)) storage.makeEntity();
+                          return storage;
+                      },
+                      [](MapStorage& storage) {
+                          for (auto e : storage.entities()) {
+                              storage.add<PositionComponent>(e);
+                              storage.add<VelocityComponent>(e);
+                          }
+                          bench::doNotOptimize(storage);
+                      });
+              } },
+          { "add.pool",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT * 2,
+                      [] { return makeWorld(false); },
+                      [](entities::EntityManager& world) {
+                          for (auto e : world.entities()) {
+                              world.addComponent<PositionComponent>(e);
+                              world.addComponent<VelocityComponent>(e);
+                          }
+                          bench::doNotOptimize(world);
+                      });
+              } },
+          { "remove.map",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] { return makeMapStorage(); },
+                      [](MapStorage& storage) {
+                          for (auto e : storage.entities()) storage.remove<PositionComponent>(e);
+                          bench::doNotOptimize(storage);
+                      });
+              } },
+          { "remove.pool",
+              [](bench::State& state) {
+                  state.run(
+                      ENTITY_COUNT,
+                      [] { return makeWorld(true); },
+                      [](entities::EntityManager& world) {
+                          for (auto e : world.entities())
+                              world.destroyComponent<PositionComponent>(e);
+                          bench::doNotOptimize(world);
+                      });
+              } },
+          }
+    };
+} // namespace
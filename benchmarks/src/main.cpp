@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import stormkit.Core;
+
+import std;
+
+import Bench;
+
+#include <stormkit/Main/MainMacro.hpp>
+
+#if defined(_MSC_VER)
+    #include <malloc.h>
+#endif
+
+////////////////////////////////////////
+/// global allocation functions replaced to count the allocations of the benchmarks, the
+/// array and sized forms forward to these by default
+////////////////////////////////////////
+auto operator new(std::size_t size) -> void* {
+    bench::details::recordAllocation();
+
+    if (auto ptr = std::malloc(std::max<std::size_t>(size, 1)); ptr) return ptr;
+
+    throw std::bad_alloc {};
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    bench::details::recordAllocation();
+
+    const auto align = static_cast<std::size_t>(alignment);
+    const auto bytes = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+#if defined(_MSC_VER)
+    if (auto ptr = _aligned_malloc(bytes, align); ptr) return ptr;
+#else
+    if (auto ptr = std::aligned_alloc(align, bytes); ptr) return ptr;
+#endif
+
+    throw std::bad_alloc {};
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t) noexcept -> void {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+auto main(std::span<const std::string_view> args) noexcept -> int {
+    bench::parseArgs(args);
+
+    return bench::runBenchmarks();
+}
@@ -0,0 +1,21 @@
+for name, _ in pairs(modules) do
+	if has_config("benchmarks_" .. name) then
+		target(name .. "-bench", function()
+			set_group("benchmarks")
+			set_kind("binary")
+			set_languages("cxxlatest", "clatest")
+
+			add_files("src/main.cpp", path.join("src", name, "**.cpp"), "src/Bench.mpp")
+
+			if has_config("mold") then
+				add_ldflags("-Wl,-fuse-ld=mold")
+				add_shflags("-Wl,-fuse-ld=mold")
+			end
+
+			if is_plat("windows") then add_syslinks("psapi") end
+
+			add_deps("stormkit-main")
+			add_deps("stormkit-" .. name)
+		end)
+	end
+end
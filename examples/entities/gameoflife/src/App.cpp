@@ -142,7 +142,7 @@ auto App::handleMouse(const stormkit::wsi::MouseButtonPushedEventData& event) ->
 
     const auto cells = m_entities.entitiesWithComponent<PositionComponent>();
     const auto it    = std::ranges::find_if(cells, [&](const auto e) {
-        const auto& position = m_entities.getComponent<PositionComponent>(e);
+        const auto& position = std::as_const(m_entities).getComponent<PositionComponent>(e);
 
         return position.x == x && position.y == y;
     });
@@ -18,6 +18,7 @@ UpdateBoardSystem::UpdateBoardSystem(stormkit::image::Image&  board,
                                      entities::EntityManager& manager)
     : entities::System { manager, 0, { PositionComponent::TYPE } }, m_board { &board },
       m_renderer { &renderer }, m_last_update { Clock::now() } {
+    subscribe({});
 }
 
 UpdateBoardSystem::~UpdateBoardSystem()                                               = default;
@@ -56,9 +57,7 @@ auto UpdateBoardSystem::update(stormkit::Secondf delta) -> void {
         return Cell { i % BOARD_SIZE, i / BOARD_SIZE };
     });
 
-    for (const auto e : m_entities) {
-        const auto& position = m_manager->getComponent<PositionComponent>(e);
-
+    for (auto&& [e, position] : m_manager->view<PositionComponent>()) {
         auto it
             = std::ranges::find_if(cell_status, [x = position.x, y = position.y](const auto& cell) {
                   return cell.x == x && cell.y == y;
@@ -158,9 +157,7 @@ auto UpdateBoardSystem::postUpdate() -> void {
             pixel[3]   = 255_b;
         }
 
-        for (const auto e : m_entities) {
-            const auto& position = m_manager->getComponent<PositionComponent>(e);
-
+        for (auto&& [_, position] : m_manager->view<PositionComponent>()) {
             auto pixel = board.pixel({ position.x, position.y, 0 });
             pixel[0]   = 255_b;
             pixel[1]   = 255_b;
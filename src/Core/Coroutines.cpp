@@ -0,0 +1,147 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+module stormkit.Core;
+
+import std;
+
+namespace stormkit {
+    namespace {
+        constexpr auto SIZE_CLASS_COUNT = CoroutineFrameAllocator::MAX_POOLED_SIZE
+                                          / CoroutineFrameAllocator::GRANULARITY;
+        /// frames kept by a thread for each size class before giving a batch back
+        constexpr auto CACHE_CAPACITY = UInt32 { 64 };
+        constexpr auto BATCH_SIZE     = UInt32 { 32 };
+
+        struct FreeFrame {
+            FreeFrame* next;
+        };
+
+        using FrameLists = std::array<FreeFrame*, SIZE_CLASS_COUNT>;
+
+        /// Frames given back by the threads with a full cache or exiting
+        struct SharedFrameLists {
+            ~SharedFrameLists() {
+                for (auto* frame : lists)
+                    while (frame) ::operator delete(std::exchange(frame, frame->next));
+            }
+
+            std::mutex mutex;
+            FrameLists lists = {};
+        };
+
+        ////////////////////////////////////////
+        ////////////////////////////////////////
+        auto sharedFrameLists() noexcept -> SharedFrameLists& {
+            static auto lists = SharedFrameLists {};
+
+            return lists;
+        }
+
+        ////////////////////////////////////////
+        ////////////////////////////////////////
+        auto giveBack(RangeExtent size_class, FreeFrame* first, FreeFrame* last) noexcept
+            -> void {
+            auto& shared = sharedFrameLists();
+
+            auto _ = std::unique_lock { shared.mutex };
+
+            last->next               = shared.lists[size_class];
+            shared.lists[size_class] = first;
+        }
+
+        struct FrameCache {
+            FrameCache() noexcept {
+                // the shared lists must outlive the caches
+                std::ignore = sharedFrameLists();
+            }
+
+            ~FrameCache() {
+                for (auto size_class : range(SIZE_CLASS_COUNT)) {
+                    auto* first = lists[size_class];
+                    if (not first) continue;
+
+                    auto* last = first;
+                    while (last->next) last = last->next;
+                    giveBack(size_class, first, last);
+                }
+            }
+
+            FrameLists                           lists  = {};
+            std::array<UInt32, SIZE_CLASS_COUNT> counts = {};
+        };
+
+        thread_local auto frame_cache = FrameCache {};
+
+        ////////////////////////////////////////
+        ////////////////////////////////////////
+        constexpr auto sizeClassOf(RangeExtent size) noexcept -> RangeExtent {
+            return (std::max(size, RangeExtent { 1 }) - 1) / CoroutineFrameAllocator::GRANULARITY;
+        }
+
+        ////////////////////////////////////////
+        ////////////////////////////////////////
+        auto refill(FrameCache& cache, RangeExtent size_class) noexcept -> void {
+            auto& shared = sharedFrameLists();
+
+            auto _ = std::unique_lock { shared.mutex };
+
+            auto& frame = shared.lists[size_class];
+            while (frame and cache.counts[size_class] < BATCH_SIZE) {
+                auto* next              = frame->next;
+                frame->next             = cache.lists[size_class];
+                cache.lists[size_class] = frame;
+                frame                   = next;
+                ++cache.counts[size_class];
+            }
+        }
+    } // namespace
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CoroutineFrameAllocator::allocate(RangeExtent size) -> void* {
+        if (size > MAX_POOLED_SIZE) return ::operator new(size);
+
+        const auto size_class = sizeClassOf(size);
+
+        auto& cache = frame_cache;
+        if (not cache.lists[size_class]) refill(cache, size_class);
+
+        if (auto* frame = cache.lists[size_class]; frame) [[likely]] {
+            cache.lists[size_class] = frame->next;
+            --cache.counts[size_class];
+
+            return frame;
+        }
+
+        return ::operator new((size_class + 1) * GRANULARITY);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CoroutineFrameAllocator::deallocate(void* frame, RangeExtent size) noexcept -> void {
+        if (size > MAX_POOLED_SIZE) {
+            ::operator delete(frame, size);
+            return;
+        }
+
+        const auto size_class = sizeClassOf(size);
+
+        auto& cache = frame_cache;
+        if (cache.counts[size_class] == CACHE_CAPACITY) [[unlikely]] {
+            auto* first = cache.lists[size_class];
+            auto* last  = first;
+            for ([[maybe_unused]] auto _ : range(BATCH_SIZE - 1)) last = last->next;
+
+            cache.lists[size_class]   = std::exchange(last->next, nullptr);
+            cache.counts[size_class] -= BATCH_SIZE;
+            giveBack(size_class, first, last);
+        }
+
+        auto* free_frame        = std::construct_at(static_cast<FreeFrame*>(frame));
+        free_frame->next        = cache.lists[size_class];
+        cache.lists[size_class] = free_frame;
+        ++cache.counts[size_class];
+    }
+} // namespace stormkit
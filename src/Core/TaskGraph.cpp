@@ -0,0 +1,225 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+module stormkit.Core;
+
+import std;
+
+namespace stormkit {
+    /////////////////////////////////////
+    /////////////////////////////////////
+    TaskGraph::TaskGraph() noexcept = default;
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    TaskGraph::~TaskGraph() {
+        expects(isDone(), "TaskGraph destroyed while running");
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    TaskGraph::TaskGraph(TaskGraph&& other) noexcept
+        : m_works { std::move(other.m_works) },
+          m_dependencies { std::move(other.m_dependencies) },
+          m_dirty { std::exchange(other.m_dirty, false) },
+          m_successor_offsets { std::move(other.m_successor_offsets) },
+          m_successors { std::move(other.m_successors) },
+          m_predecessor_counts { std::move(other.m_predecessor_counts) },
+          m_roots { std::move(other.m_roots) },
+          m_order { std::move(other.m_order) },
+          m_remaining_predecessors { std::move(other.m_remaining_predecessors) },
+          m_remaining_capacity { std::exchange(other.m_remaining_capacity, 0) } {
+        expects(other.isDone(), "TaskGraph moved while running");
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::operator=(TaskGraph&& other) noexcept -> TaskGraph& {
+        if (&other == this) [[unlikely]]
+            return *this;
+
+        expects(isDone() and other.isDone(), "TaskGraph moved while running");
+
+        m_works                  = std::move(other.m_works);
+        m_dependencies           = std::move(other.m_dependencies);
+        m_dirty                  = std::exchange(other.m_dirty, false);
+        m_successor_offsets      = std::move(other.m_successor_offsets);
+        m_successors             = std::move(other.m_successors);
+        m_predecessor_counts     = std::move(other.m_predecessor_counts);
+        m_roots                  = std::move(other.m_roots);
+        m_order                  = std::move(other.m_order);
+        m_remaining_predecessors = std::move(other.m_remaining_predecessors);
+        m_remaining_capacity     = std::exchange(other.m_remaining_capacity, 0);
+        m_pool                   = nullptr;
+        m_exception              = nullptr;
+
+        return *this;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::addDependency(NodeID node, NodeID dependency) -> void {
+        expects(isDone(), "TaskGraph modified while running");
+        expects(node < size() and dependency < size());
+        expects(node != dependency);
+
+        m_dependencies.emplace_back(dependency, node);
+        m_dirty = true;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::reserve(RangeExtent node_count, RangeExtent dependency_count) -> void {
+        m_works.reserve(node_count);
+        m_dependencies.reserve(dependency_count);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::clear() noexcept -> void {
+        expects(isDone(), "TaskGraph modified while running");
+
+        m_works.clear();
+        m_dependencies.clear();
+        m_dirty = true;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::submit(ThreadPool& pool) -> void {
+        expects(isDone(), "TaskGraph submitted while running");
+
+        if (m_dirty) build();
+
+        m_pool      = &pool;
+        m_exception = nullptr;
+        m_failed.clear(std::memory_order_relaxed);
+
+        if (empty()) return;
+
+        for (auto i : range(size()))
+            m_remaining_predecessors[i].store(m_predecessor_counts[i], std::memory_order_relaxed);
+
+        // nothing would run the posted nodes, run the graph on this thread
+        if (pool.workerCount() == 0) {
+            for (auto node : m_order) {
+                try {
+                    m_works[node]();
+                } catch (...) {
+                    m_exception = std::current_exception();
+                    break;
+                }
+            }
+            return;
+        }
+
+        m_pending.store(as<UInt32>(size()), std::memory_order_release);
+        for (auto root : m_roots) post(root);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::wait() -> void {
+        if (m_pool) m_pool->waitUntilDone(m_pending);
+
+        if (m_exception) std::rethrow_exception(std::exchange(m_exception, nullptr));
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::addWork(Work&& work) -> NodeID {
+        expects(isDone(), "TaskGraph modified while running");
+        expects(size() < NO_NODE);
+
+        const auto id = as<NodeID>(size());
+        m_works.emplace_back(std::move(work));
+        m_dirty = true;
+
+        return id;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::build() -> void {
+        const auto node_count = size();
+
+        // compressed successor lists
+        m_predecessor_counts.assign(node_count, 0);
+        m_successor_offsets.assign(node_count + 1, 0);
+        for (const auto& [dependency, node] : m_dependencies) {
+            ++m_successor_offsets[dependency + 1];
+            ++m_predecessor_counts[node];
+        }
+        std::partial_sum(std::begin(m_successor_offsets),
+                         std::end(m_successor_offsets),
+                         std::begin(m_successor_offsets));
+
+        m_successors.resize(std::size(m_dependencies));
+        auto cursors = std::vector<UInt32> { std::begin(m_successor_offsets),
+                                             std::end(m_successor_offsets) - 1 };
+        for (const auto& [dependency, node] : m_dependencies)
+            m_successors[cursors[dependency]++] = node;
+
+        m_roots.clear();
+        for (auto node : range(as<NodeID>(node_count)))
+            if (m_predecessor_counts[node] == 0) m_roots.emplace_back(node);
+
+        // Kahn's algorithm, gives the order used without workers and checks for cycles
+        auto remaining = m_predecessor_counts;
+        m_order.assign(std::begin(m_roots), std::end(m_roots));
+        m_order.reserve(node_count);
+        for (auto i = RangeExtent { 0 }; i < std::size(m_order); ++i) {
+            const auto node = m_order[i];
+            for (auto j : range(m_successor_offsets[node], m_successor_offsets[node + 1]))
+                if (--remaining[m_successors[j]] == 0) m_order.emplace_back(m_successors[j]);
+        }
+        expects(std::size(m_order) == node_count, "TaskGraph has a cycle");
+
+        if (m_remaining_capacity < node_count) {
+            m_remaining_predecessors = std::make_unique<std::atomic<UInt32>[]>(node_count);
+            m_remaining_capacity     = node_count;
+        }
+
+        m_dirty = false;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::post(NodeID node) -> void {
+        m_pool->postTask<void>([this, node] { execute(node); }, ThreadPool::NoFuture);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto TaskGraph::execute(NodeID node) noexcept -> void {
+        while (node != NO_NODE) {
+            if (not m_failed.test(std::memory_order_relaxed)) {
+                try {
+                    m_works[node]();
+                } catch (...) {
+                    if (not m_failed.test_and_set(std::memory_order_relaxed))
+                        m_exception = std::current_exception();
+                }
+            }
+
+            // run one of the nodes made ready as a continuation, post the others
+            auto next = NO_NODE;
+            for (auto i : range(m_successor_offsets[node], m_successor_offsets[node + 1])) {
+                const auto successor = m_successors[i];
+                if (m_remaining_predecessors[successor].fetch_sub(1, std::memory_order_acq_rel)
+                    != 1)
+                    continue;
+
+                if (next != NO_NODE) post(next);
+                next = successor;
+            }
+
+            // the graph may be destroyed as soon as the last node counted down, unless this
+            // node made another one ready
+            auto& pool = *m_pool;
+            pool.countDown(m_pending);
+            node = next;
+        }
+    }
+} // namespace stormkit
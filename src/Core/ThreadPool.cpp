@@ -7,41 +7,525 @@ module stormkit.Core;
 import std;
 
 namespace stormkit {
+    namespace {
+        constexpr auto CACHE_LINE_SIZE = RangeExtent { 64 };
+
+        /// Chase-Lev deque ("Correct and Efficient Work-Stealing for Weak Memory Models", Le et
+        /// al. 2013), the owner thread pushes and pops at the bottom, any thread can steal at the
+        /// top. The buffers replaced when growing are kept alive until the deque is destroyed as
+        /// a thief may still read them.
+        template<class T>
+        class WorkStealingDeque {
+          public:
+            static constexpr auto INITIAL_CAPACITY = Int64 { 256 };
+
+            WorkStealingDeque() {
+                auto& buffer = m_buffers.emplace_back(std::make_unique<Buffer>(INITIAL_CAPACITY));
+                m_buffer.store(buffer.get(), std::memory_order_relaxed);
+            }
+
+            /// Owner only
+            auto push(T* value) -> void {
+                const auto bottom = m_bottom.load(std::memory_order_relaxed);
+                const auto top    = m_top.load(std::memory_order_acquire);
+                auto*      buffer = m_buffer.load(std::memory_order_relaxed);
+
+                if (bottom - top > buffer->capacity - 1) buffer = grow(buffer, top, bottom);
+
+                buffer->store(bottom, value);
+                m_bottom.store(bottom + 1, std::memory_order_release);
+            }
+
+            /// Owner only, returns nullptr if the deque is empty
+            auto pop() noexcept -> T* {
+                const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+                auto*      buffer = m_buffer.load(std::memory_order_relaxed);
+                m_bottom.store(bottom, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                auto top = m_top.load(std::memory_order_relaxed);
+
+                if (top > bottom) {
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                auto* value = buffer->load(bottom);
+                if (top == bottom) {
+                    // last element, race with the thieves
+                    if (not m_top.compare_exchange_strong(top,
+                                                          top + 1,
+                                                          std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed))
+                        value = nullptr;
+                    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                }
+
+                return value;
+            }
+
+            /// Returns nullptr if the deque is empty or if another thread won the race
+            auto steal() noexcept -> T* {
+                auto top = m_top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+                if (top >= bottom) return nullptr;
+
+                auto* value = m_buffer.load(std::memory_order_acquire)->load(top);
+                if (not m_top.compare_exchange_strong(top,
+                                                      top + 1,
+                                                      std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed))
+                    return nullptr;
+
+                return value;
+            }
+
+            [[nodiscard]] auto empty() const noexcept -> bool {
+                return m_bottom.load(std::memory_order_relaxed)
+                       <= m_top.load(std::memory_order_relaxed);
+            }
+
+          private:
+            struct Buffer {
+                explicit Buffer(Int64 _capacity)
+                    : capacity { _capacity },
+                      slots {
+                          std::make_unique<std::atomic<T*>[]>(as<RangeExtent>(_capacity))
+                      } {}
+
+                auto load(Int64 index) const noexcept -> T* {
+                    const auto slot = as<RangeExtent>(index & (capacity - 1));
+                    return slots[slot].load(std::memory_order_relaxed);
+                }
+
+                auto store(Int64 index, T* value) noexcept -> void {
+                    const auto slot = as<RangeExtent>(index & (capacity - 1));
+                    slots[slot].store(value, std::memory_order_relaxed);
+                }
+
+                Int64                              capacity;
+                std::unique_ptr<std::atomic<T*>[]> slots;
+            };
+
+            auto grow(Buffer* buffer, Int64 top, Int64 bottom) -> Buffer* {
+                const auto capacity = buffer->capacity * 2;
+                auto&      grown    = m_buffers.emplace_back(std::make_unique<Buffer>(capacity));
+                for (auto i = top; i < bottom; ++i) grown->store(i, buffer->load(i));
+
+                m_buffer.store(grown.get(), std::memory_order_release);
+
+                return grown.get();
+            }
+
+            alignas(CACHE_LINE_SIZE) std::atomic<Int64> m_top    = 0;
+            alignas(CACHE_LINE_SIZE) std::atomic<Int64> m_bottom = 0;
+
+            std::vector<std::unique_ptr<Buffer>> m_buffers;
+            std::atomic<Buffer*>                 m_buffer;
+        };
+    } // namespace
+
+    /// Fixed size blocks recycled for the tasks and the future states. Each worker keeps a cache
+    /// of free blocks and exchanges batches with a shared cache, the other threads go through
+    /// the shared cache. Future states may outlive the pool so the allocator is reference
+    /// counted.
+    class ThreadPool::BlockAllocator {
+      public:
+        /// Blocks kept by a worker before handing a batch back to the shared cache
+        static constexpr auto CACHE_CAPACITY = RangeExtent { 256 };
+        static constexpr auto BATCH_SIZE     = RangeExtent { 64 };
+
+        static_assert(sizeof(Task) <= BLOCK_SIZE);
+
+        explicit BlockAllocator(RangeExtent worker_count);
+        ~BlockAllocator();
+
+        BlockAllocator(const BlockAllocator&)                    = delete;
+        auto operator=(const BlockAllocator&) -> BlockAllocator& = delete;
+
+        [[nodiscard]] auto allocate(std::optional<UInt32> worker) -> void*;
+        auto deallocate(void* block, std::optional<UInt32> worker) noexcept -> void;
+
+        auto retain() noexcept -> void;
+        /// Deletes the allocator once the last reference is released
+        auto release() noexcept -> void;
+
+      private:
+        struct alignas(CACHE_LINE_SIZE) Cache {
+            std::vector<void*> blocks;
+        };
+
+        std::vector<Cache> m_caches;
+
+        std::mutex         m_mutex;
+        std::vector<void*> m_blocks;
+
+        std::atomic<UInt32> m_references = 1;
+    };
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::BlockAllocator::BlockAllocator(RangeExtent worker_count) : m_caches(worker_count) {
+        for (auto& cache : m_caches) cache.blocks.reserve(CACHE_CAPACITY);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::BlockAllocator::~BlockAllocator() {
+        for (auto& cache : m_caches)
+            for (auto* block : cache.blocks) ::operator delete(block);
+
+        for (auto* block : m_blocks) ::operator delete(block);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::BlockAllocator::allocate(std::optional<UInt32> worker) -> void* {
+        if (worker) {
+            auto& blocks = m_caches[*worker].blocks;
+            if (std::empty(blocks)) {
+                auto       lock  = std::unique_lock { m_mutex };
+                const auto count = std::min(BATCH_SIZE, std::size(m_blocks));
+                blocks.insert(std::end(blocks), std::end(m_blocks) - count, std::end(m_blocks));
+                m_blocks.resize(std::size(m_blocks) - count);
+            }
+
+            if (not std::empty(blocks)) {
+                auto* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+        } else {
+            auto lock = std::unique_lock { m_mutex };
+            if (not std::empty(m_blocks)) {
+                auto* block = m_blocks.back();
+                m_blocks.pop_back();
+                return block;
+            }
+        }
+
+        return ::operator new(BLOCK_SIZE);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::BlockAllocator::deallocate(void* block, std::optional<UInt32> worker) noexcept
+        -> void {
+        if (worker) {
+            auto& blocks = m_caches[*worker].blocks;
+            if (std::size(blocks) < CACHE_CAPACITY) {
+                blocks.push_back(block);
+                return;
+            }
+
+            const auto batch = std::end(blocks) - BATCH_SIZE;
+            try {
+                auto lock = std::unique_lock { m_mutex };
+                m_blocks.insert(std::end(m_blocks), batch, std::end(blocks));
+            } catch (...) {
+                std::ranges::for_each(batch, std::end(blocks), [](auto* block) {
+                    ::operator delete(block);
+                });
+            }
+            blocks.erase(batch, std::end(blocks));
+            blocks.push_back(block);
+
+            return;
+        }
+
+        try {
+            auto lock = std::unique_lock { m_mutex };
+            m_blocks.push_back(block);
+        } catch (...) { ::operator delete(block); }
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::BlockAllocator::retain() noexcept -> void {
+        m_references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::BlockAllocator::release() noexcept -> void {
+        if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+
+    struct ThreadPool::Scheduler {
+        /// Failed searches before an idle worker parks, the last ones yield between the searches
+        static constexpr auto SPIN_COUNT  = 64u;
+        static constexpr auto YIELD_AFTER = 16u;
+
+        struct alignas(CACHE_LINE_SIZE) Worker {
+            WorkStealingDeque<Task> tasks;
+        };
+
+        explicit Scheduler(RangeExtent worker_count);
+        ~Scheduler();
+
+        /// Index of the calling thread if it is one of our workers
+        [[nodiscard]] auto currentWorker() const noexcept -> std::optional<UInt32>;
+
+        auto push(Task* task) -> void;
+        auto stop() noexcept -> void;
+
+        auto workerMain(UInt32 index) noexcept -> void;
+
+        [[nodiscard]] auto findTask(UInt32 index) noexcept -> Task*;
+        [[nodiscard]] auto popInjected() noexcept -> Task*;
+        [[nodiscard]] auto hasWork() const noexcept -> bool;
+
+        /// Sleeps until new work is posted, or until `pending` reaches zero if given
+        auto park(const std::atomic<UInt32>* pending = nullptr) noexcept -> void;
+        auto notify() noexcept -> void;
+        auto notifyAll() noexcept -> void;
+
+        auto run(Task* task, UInt32 index) noexcept -> void;
+        /// Destroy a task and give its block back
+        auto discard(Task* task, std::optional<UInt32> worker) noexcept -> void;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        BlockAllocator*                      allocator;
+
+        /// first in first out, the storage is only cleared once drained so it is reused
+        std::mutex               injection_mutex;
+        std::vector<Task*>       injection;
+        RangeExtent              injection_head = 0;
+        std::atomic<RangeExtent> injected_count = 0;
+
+        std::atomic<UInt32> sleeper_count = 0;
+        /// bumped to wake the parked workers
+        std::atomic<UInt32> epoch    = 0;
+        std::atomic<bool>   stopping = false;
+
+        /// bumped by countDown() when a counter reaches zero, the other threads in
+        /// waitUntilDone() wait on it rather than on the counter which may be destroyed as soon
+        /// as it is zero
+        std::atomic<UInt32> completion_epoch = 0;
+
+        /// scheduler and index of the worker running on this thread
+        static thread_local Scheduler* current;
+        static thread_local UInt32     current_index;
+    };
+
+    thread_local ThreadPool::Scheduler* ThreadPool::Scheduler::current       = nullptr;
+    thread_local UInt32                 ThreadPool::Scheduler::current_index = 0;
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::Scheduler::Scheduler(RangeExtent worker_count)
+        : allocator { new BlockAllocator { worker_count } } {
+        workers.reserve(worker_count);
+        for ([[maybe_unused]] auto _ : range(worker_count))
+            workers.emplace_back(std::make_unique<Worker>());
+    }
+
+    /////////////////////////////////////
     /////////////////////////////////////
+    ThreadPool::Scheduler::~Scheduler() {
+        // only reached without workers left, tasks posted to a pool without workers never ran
+        for (auto& worker : workers)
+            while (auto* task = worker->tasks.pop()) discard(task, std::nullopt);
+
+        for (auto* task : injection | std::views::drop(injection_head))
+            discard(task, std::nullopt);
+
+        allocator->release();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::currentWorker() const noexcept -> std::optional<UInt32> {
+        if (current != this) return std::nullopt;
+
+        return current_index;
+    }
+
     /////////////////////////////////////
-    ThreadPool::ThreadPool(ThreadPool&& other) noexcept {
-        auto lock = std::scoped_lock { other.m_mutex };
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::push(Task* task) -> void {
+        if (current == this) workers[current_index]->tasks.push(task);
+        else {
+            auto lock = std::unique_lock { injection_mutex };
+            injection.push_back(task);
+            injected_count.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        m_worker_count = std::exchange(other.m_worker_count, 0u);
-        m_tasks        = std::move(other.m_tasks);
+        notify();
+    }
 
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::stop() noexcept -> void {
+        stopping.store(true, std::memory_order_seq_cst);
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        epoch.notify_all();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::workerMain(UInt32 index) noexcept -> void {
+        current       = this;
+        current_index = index;
+
+        auto failed_searches = 0u;
+        for (;;) {
+            if (auto* task = findTask(index); task) {
+                failed_searches = 0;
+
+                run(task, index);
+                continue;
+            }
+
+            // the pool is joined once all the work, including the tasks posted by the running
+            // tasks, is done
+            if (stopping.load(std::memory_order_acquire)) break;
+
+            if (failed_searches < SPIN_COUNT) {
+                if (++failed_searches > YIELD_AFTER) std::this_thread::yield();
+                continue;
+            }
+
+            park();
+            failed_searches = 0;
+        }
+
+        current = nullptr;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::findTask(UInt32 index) noexcept -> Task* {
+        if (auto* task = workers[index]->tasks.pop(); task) return task;
+        if (auto* task = popInjected(); task) return task;
+
+        // start after our own deque so the thieves are spread over the victims
+        const auto worker_count = as<UInt32>(std::size(workers));
+        for (auto i : range(1u, worker_count)) {
+            const auto victim = (index + i) % worker_count;
+            if (auto* task = workers[victim]->tasks.steal(); task) return task;
+        }
+
+        return nullptr;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::popInjected() noexcept -> Task* {
+        if (injected_count.load(std::memory_order_relaxed) == 0) return nullptr;
+
+        auto lock = std::unique_lock { injection_mutex };
+        if (injection_head == std::size(injection)) return nullptr;
+
+        auto* task = injection[injection_head++];
+        if (injection_head == std::size(injection)) {
+            injection.clear();
+            injection_head = 0;
+        }
+        injected_count.fetch_sub(1, std::memory_order_relaxed);
+
+        return task;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::hasWork() const noexcept -> bool {
+        if (injected_count.load(std::memory_order_seq_cst) != 0) return true;
+
+        return std::ranges::any_of(workers,
+                                   [](const auto& worker) { return not worker->tasks.empty(); });
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::park(const std::atomic<UInt32>* pending) noexcept -> void {
+        // announce the sleep before checking for work a last time, a push done after this
+        // check sees the sleeper and bumps the epoch
+        sleeper_count.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto current_epoch = epoch.load(std::memory_order_seq_cst);
+
+        const auto done = pending and pending->load(std::memory_order_seq_cst) == 0;
+        if (not done and not hasWork() and not stopping.load(std::memory_order_seq_cst))
+            epoch.wait(current_epoch, std::memory_order_seq_cst);
+
+        sleeper_count.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::notify() noexcept -> void {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeper_count.load(std::memory_order_seq_cst) == 0) return;
+
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        epoch.notify_one();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::notifyAll() noexcept -> void {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeper_count.load(std::memory_order_seq_cst) == 0) return;
+
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        epoch.notify_all();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::run(Task* task, UInt32 index) noexcept -> void {
+        (*task)();
+        discard(task, index);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::Scheduler::discard(Task* task, std::optional<UInt32> worker) noexcept -> void {
+        std::destroy_at(task);
+        allocator->deallocate(task, worker);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::ThreadPool(Int worker_count)
+        : m_worker_count { worker_count },
+          m_scheduler { std::make_unique<Scheduler>(as<RangeExtent>(worker_count)) } {
         m_workers.reserve(m_worker_count);
+
         for (const auto i : range(m_worker_count)) {
-            auto& thread = m_workers.emplace_back([this] { workerMain(); });
-            setThreadName(thread, std::format("StormKit:WorkerThread:{}", i));
+            auto& worker = m_workers.emplace_back(
+                [scheduler = m_scheduler.get(), i] { scheduler->workerMain(as<UInt32>(i)); });
+            setThreadName(worker, std::format("StormKit:WorkerThread:{}", i));
         }
     }
 
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::~ThreadPool() {
+        joinAll();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ThreadPool::ThreadPool(ThreadPool&& other) noexcept
+        : m_worker_count { std::exchange(other.m_worker_count, 0) },
+          m_workers { std::move(other.m_workers) },
+          m_scheduler { std::move(other.m_scheduler) } {
+    }
+
     /////////////////////////////////////
     /////////////////////////////////////
     auto ThreadPool::operator=(ThreadPool&& other) noexcept -> ThreadPool& {
         if (&other == this) [[unlikely]]
             return *this;
 
-        auto lock1 = std::unique_lock { other.m_mutex, std::defer_lock };
-        auto lock2 = std::unique_lock { other.m_mutex, std::defer_lock };
-        std::lock(lock1, lock2);
-
         joinAll();
 
-        m_worker_count = std::exchange(other.m_worker_count, 0u);
-        m_tasks        = std::move(other.m_tasks);
-
-        m_workers.reserve(m_worker_count);
-        for (const auto i : range(m_worker_count)) {
-            auto& thread = m_workers.emplace_back([this] { workerMain(); });
-            setThreadName(thread, std::format("StormKit:WorkerThread:{}", i));
-        }
+        m_worker_count = std::exchange(other.m_worker_count, 0);
+        m_workers      = std::move(other.m_workers);
+        m_scheduler    = std::move(other.m_scheduler);
 
         return *this;
     }
@@ -49,8 +533,9 @@ namespace stormkit {
     /////////////////////////////////////
     /////////////////////////////////////
     auto ThreadPool::joinAll() -> void {
-        for ([[maybe_unused]] const auto i : range(m_worker_count))
-            postTask<void>(Task::Type::Terminate, [] {}, ThreadPool::NoFuture);
+        if (not m_scheduler) return;
+
+        m_scheduler->stop();
 
         for (auto& thread : m_workers)
             if (thread.joinable()) thread.join();
@@ -58,22 +543,87 @@ namespace stormkit {
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto ThreadPool::workerMain() noexcept -> void {
-        for (;;) {
-            auto task = Task {};
+    auto ThreadPool::countDown(std::atomic<UInt32>& pending) noexcept -> void {
+        if (pending.fetch_sub(1, std::memory_order_seq_cst) != 1) return;
 
-            {
-                auto lock = std::unique_lock { m_mutex };
-                if (std::empty(m_tasks))
-                    m_work_signal.wait(lock, [this] { return not std::empty(m_tasks); });
+        // the workers helping in waitUntilDone() park with the idle ones
+        m_scheduler->notifyAll();
 
-                task = std::move(m_tasks.front());
-                m_tasks.pop();
+        m_scheduler->completion_epoch.fetch_add(1, std::memory_order_seq_cst);
+        m_scheduler->completion_epoch.notify_all();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::waitUntilDone(const std::atomic<UInt32>& pending) noexcept -> void {
+        expects(m_scheduler != nullptr);
+
+        auto&      scheduler = *m_scheduler;
+        const auto worker    = scheduler.currentWorker();
+
+        if (not worker) {
+            for (;;) {
+                // read before the counter, a countDown() done after this read changes the epoch
+                const auto epoch = scheduler.completion_epoch.load(std::memory_order_seq_cst);
+                if (pending.load(std::memory_order_seq_cst) == 0) return;
+
+                scheduler.completion_epoch.wait(epoch, std::memory_order_seq_cst);
             }
+        }
 
-            task.work();
+        auto failed_searches = 0u;
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (auto* task = scheduler.findTask(*worker); task) {
+                failed_searches = 0;
+                scheduler.run(task, *worker);
+                continue;
+            }
+
+            if (failed_searches < Scheduler::SPIN_COUNT) {
+                if (++failed_searches > Scheduler::YIELD_AFTER) std::this_thread::yield();
+                continue;
+            }
 
-            if (task.type == Task::Type::Terminate) return;
+            scheduler.park(&pending);
+            failed_searches = 0;
         }
     }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::allocateBlock() -> void* {
+        expects(m_scheduler != nullptr);
+
+        return m_scheduler->allocator->allocate(m_scheduler->currentWorker());
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::allocateStateBlock() -> StateBlock {
+        auto* memory    = allocateBlock();
+        auto* allocator = m_scheduler->allocator;
+        allocator->retain();
+
+        return { memory, allocator };
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::releaseStateBlock(BlockAllocator* allocator, void* memory) noexcept -> void {
+        const auto* scheduler = Scheduler::current;
+        const auto  worker    = (scheduler and scheduler->allocator == allocator)
+                                    ? std::optional { Scheduler::current_index }
+                                    : std::nullopt;
+
+        allocator->deallocate(memory, worker);
+        allocator->release();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ThreadPool::enqueue(Task* task) -> void {
+        expects(m_scheduler != nullptr);
+
+        m_scheduler->push(task);
+    }
 } // namespace stormkit
@@ -0,0 +1,171 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+module stormkit.Entities;
+
+import std;
+
+import stormkit.Core;
+
+namespace stormkit::entities {
+    namespace {
+        auto next_buffer_id = std::atomic<UInt64> { 1 };
+
+        auto makeBufferId() noexcept -> UInt64 {
+            return next_buffer_id.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    CommandBuffer::CommandBuffer() : m_id { makeBufferId() } {
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    CommandBuffer::~CommandBuffer() = default;
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept {
+        auto lock = std::scoped_lock { other.m_mutex };
+
+        // lanes are cached per thread by buffer id, the id follow the lanes
+        m_id    = std::exchange(other.m_id, makeBufferId());
+        m_owned = other.m_owned;
+        m_lanes = std::move(other.m_lanes);
+        m_next_index.store(other.m_next_index.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::operator=(CommandBuffer&& other) noexcept -> CommandBuffer& {
+        if (&other == this) [[unlikely]]
+            return *this;
+
+        auto lock = std::scoped_lock { m_mutex, other.m_mutex };
+
+        m_id    = std::exchange(other.m_id, makeBufferId());
+        m_owned = other.m_owned;
+        m_lanes = std::move(other.m_lanes);
+        m_next_index.store(other.m_next_index.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+
+        return *this;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::makeEntity() -> Entity {
+        // a standalone buffer can't know which indices are free in the EntityManager it will
+        // be played back into
+        expects(m_owned, "makeEntity() is only available on EntityManager::commands()");
+
+        const auto entity = entityHandle(reserveIndex(), 0);
+
+        lane().commands.emplace_back(Command::Kind::MakeEntity, Component::INVALID_TYPE, entity);
+
+        return entity;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::destroyEntity(Entity entity) -> void {
+        expects(entity != INVALID_ENTITY);
+
+        lane().commands.emplace_back(Command::Kind::DestroyEntity, Component::INVALID_TYPE, entity);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::playback(EntityManager& manager) -> void {
+        auto& commands = m_playback_commands;
+
+        {
+            auto lock = std::scoped_lock { m_mutex };
+            for (auto& lane : m_lanes) {
+                std::ranges::move(lane->commands, std::back_inserter(commands));
+                lane->commands.clear();
+            }
+        }
+
+        if (std::empty(commands)) return;
+
+        std::ranges::stable_sort(commands, {}, [](const Command& command) static noexcept {
+            // additions and removals of a component share a group and keep their recording
+            // order, so removing a component then adding it replaces it
+            const auto group = command.kind == Command::Kind::DestroyComponent
+                                   ? Command::Kind::AddComponent
+                                   : command.kind;
+            return std::tuple { group, command.component, command.entity };
+        });
+
+        for (auto& command : commands) {
+            switch (command.kind) {
+                case Command::Kind::MakeEntity: manager.registerEntity(command.entity); break;
+                case Command::Kind::AddComponent: [[fallthrough]];
+                case Command::Kind::DestroyComponent: command.apply(manager); break;
+                case Command::Kind::DestroyEntity: manager.destroyEntity(command.entity); break;
+            }
+        }
+
+        commands.clear();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::clear() noexcept -> void {
+        auto lock = std::scoped_lock { m_mutex };
+
+        for (auto& lane : m_lanes) lane->commands.clear();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::empty() const noexcept -> bool {
+        auto lock = std::scoped_lock { m_mutex };
+
+        return std::ranges::all_of(m_lanes, [](const auto& lane) static noexcept {
+            return std::empty(lane->commands);
+        });
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::lane() -> Lane& {
+        // only the last buffer used by the thread is cached, buffer ids are never reused so a
+        // destroyed buffer is never matched
+        thread_local auto cached = std::pair<UInt64, Lane*> { 0, nullptr };
+
+        if (cached.first == m_id) [[likely]]
+            return *cached.second;
+
+        const auto thread = std::this_thread::get_id();
+
+        auto lock = std::scoped_lock { m_mutex };
+
+        auto it = std::ranges::find(m_lanes, thread, [](const auto& lane) static noexcept {
+            return lane->owner;
+        });
+        if (it == std::ranges::end(m_lanes))
+            it = m_lanes.emplace(std::ranges::end(m_lanes), std::make_unique<Lane>(thread));
+
+        cached = { m_id, it->get() };
+
+        return **it;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::reserveIndex() noexcept -> EntityIndex {
+        return m_next_index.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto CommandBuffer::reserveIndices(EntityIndex count) noexcept -> EntityIndex {
+        return m_next_index.fetch_add(count, std::memory_order_relaxed);
+    }
+} // namespace stormkit::entities
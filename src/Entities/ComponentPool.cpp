@@ -0,0 +1,158 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+module stormkit.Entities;
+
+import std;
+
+import stormkit.Core;
+
+namespace stormkit::entities {
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ComponentPoolBase::ComponentPoolBase(Component::Type type, ComponentId id) noexcept
+        : m_type { type }, m_id { id } {
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    ComponentPoolBase::~ComponentPoolBase() = default;
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::insertIndex(Entity entity) -> UInt32 {
+        const auto entity_index = entityIndex(entity);
+        if (entity_index >= std::size(m_sparse)) m_sparse.resize(entity_index + 1, INVALID_INDEX);
+
+        const auto index = as<UInt32>(std::size(m_dense));
+        m_dense.emplace_back(entity);
+        m_added_ticks.emplace_back(m_tick);
+        m_changed_ticks.emplace_back(m_tick);
+        m_sparse[entity_index] = index;
+        m_structure_tick       = m_tick;
+
+        return index;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::insertIndices(std::span<const Entity> entities) -> void {
+        if (std::empty(entities)) return;
+
+        const auto max_index = entityIndex(std::ranges::max(entities, {}, entityIndex));
+        if (max_index >= std::size(m_sparse)) m_sparse.resize(max_index + 1, INVALID_INDEX);
+
+        auto index = as<UInt32>(std::size(m_dense));
+        for (auto entity : entities) {
+            auto& sparse = m_sparse[entityIndex(entity)];
+            // also catches an entity listed twice
+            expects(sparse == INVALID_INDEX);
+
+            sparse = index++;
+        }
+
+        m_dense.insert(std::ranges::end(m_dense),
+                       std::ranges::begin(entities),
+                       std::ranges::end(entities));
+        m_added_ticks.resize(std::size(m_dense), m_tick);
+        m_changed_ticks.resize(std::size(m_dense), m_tick);
+        m_structure_tick = m_tick;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::eraseIndex(Entity entity) -> std::pair<UInt32, UInt32> {
+        const auto entity_index = entityIndex(entity);
+        const auto index        = m_sparse[entity_index];
+        const auto last         = as<UInt32>(std::size(m_dense) - 1);
+
+        if (index != last) {
+            const auto moved             = m_dense[last];
+            m_dense[index]               = moved;
+            m_added_ticks[index]         = m_added_ticks[last];
+            m_changed_ticks[index]       = m_changed_ticks[last];
+            m_sparse[entityIndex(moved)] = index;
+        }
+
+        m_dense.pop_back();
+        m_added_ticks.pop_back();
+        m_changed_ticks.pop_back();
+        m_sparse[entity_index] = INVALID_INDEX;
+
+        m_removed.emplace_back(entity, m_tick);
+        m_structure_tick = m_tick;
+
+        return { index, last };
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::clearIndices() -> void {
+        for (auto entity : m_dense) m_removed.emplace_back(entity, m_tick);
+
+        m_dense.clear();
+        m_sparse.clear();
+        m_added_ticks.clear();
+        m_changed_ticks.clear();
+        m_structure_tick = m_tick;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::reorderIndices(std::span<const Entity> order) -> std::vector<UInt32> {
+        expects(std::size(order) <= std::size(m_dense));
+
+        auto permutation = std::vector<UInt32> {};
+        permutation.reserve(std::size(m_dense));
+
+        auto placed = std::vector<bool>(std::size(m_dense), false);
+        for (auto entity : order) {
+            const auto index = indexOf(entity);
+            expects(index != INVALID_INDEX and not placed[index]);
+
+            permutation.emplace_back(index);
+            placed[index] = true;
+        }
+        for (auto index : range(as<UInt32>(std::size(m_dense))))
+            if (not placed[index]) permutation.emplace_back(index);
+
+        const auto permute = [&permutation](auto& values) {
+            auto output = std::remove_cvref_t<decltype(values)> {};
+            output.reserve(std::size(values));
+            for (auto index : permutation) output.emplace_back(values[index]);
+            values = std::move(output);
+        };
+        permute(m_dense);
+        permute(m_added_ticks);
+        permute(m_changed_ticks);
+
+        for (auto index : range(as<UInt32>(std::size(m_dense))))
+            m_sparse[entityIndex(m_dense[index])] = index;
+
+        return permutation;
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::removed(Tick since) const -> std::vector<Entity> {
+        // clang-format off
+        return m_removed
+               | std::views::filter([since](const auto& pair) noexcept { return pair.second > since; })
+               | std::views::keys
+               | std::ranges::to<std::vector>();
+        // clang-format on
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::discardRemoved(Tick until) -> void {
+        std::erase_if(m_removed, [until](const auto& pair) noexcept { return pair.second <= until; });
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto ComponentPoolBase::setTick(Tick tick) noexcept -> void {
+        m_tick = tick;
+    }
+} // namespace stormkit::entities
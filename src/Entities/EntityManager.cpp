@@ -11,7 +11,11 @@ import stormkit.Core;
 namespace stormkit::entities {
     /////////////////////////////////////
     /////////////////////////////////////
-    EntityManager::EntityManager() = default;
+    EntityManager::EntityManager(ExecutionMode mode) {
+        m_commands.m_owned = true;
+
+        setExecutionMode(mode);
+    }
 
     /////////////////////////////////////
     /////////////////////////////////////
@@ -28,50 +32,125 @@ namespace stormkit::entities {
     /////////////////////////////////////
     /////////////////////////////////////
     auto EntityManager::makeEntity() -> Entity {
-        const auto entity = [this]() {
-            if (std::empty(m_free_entities)) return m_next_valid_entity++;
-            else {
-                auto entity = m_free_entities.front();
-                m_free_entities.pop();
-                return entity;
-            }
+        const auto index = [this]() {
+            // new indices are shared with the entities reserved by the command buffer
+            if (std::empty(m_free_entities)) return m_commands.reserveIndex();
+
+            auto index = m_free_entities.front();
+            m_free_entities.pop();
+            return index;
         }();
 
-        m_added_entities.emplace(entity);
-        m_updated_entities.emplace(entity);
-        m_registered_components_for_entities[entity] = {};
-        m_message_bus.push(Message { ADDED_ENTITY_MESSAGE_ID, { entity } });
+        const auto generation = index < std::size(m_slots) ? m_slots[index].generation
+                                                          : EntityGeneration { 0 };
+        const auto entity     = entityHandle(index, generation);
+
+        registerEntity(entity);
 
         return entity;
     }
 
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::registerEntity(Entity entity) -> void {
+        const auto index = entityIndex(entity);
+        if (index >= std::size(m_slots)) m_slots.resize(index + 1);
+
+        auto& slot = m_slots[index];
+        expects(slot.position == EntitySlot::FREE and slot.generation == entityGeneration(entity));
+
+        slot.position = EntitySlot::PENDING;
+
+        m_added_entities.emplace_back(entity);
+        m_message_bus.push(ADDED_ENTITY_MESSAGE_ID, entity);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::registerEntities(RangeExtent count) -> std::vector<Entity> {
+        auto entities = std::vector<Entity> {};
+        entities.reserve(count);
+
+        const auto recycled = std::min(count, std::size(m_free_entities));
+        for ([[maybe_unused]] auto _ : range(recycled)) {
+            const auto index = m_free_entities.front();
+            m_free_entities.pop();
+
+            entities.emplace_back(entityHandle(index, m_slots[index].generation));
+        }
+
+        // the remaining indices are fresh and contiguous
+        const auto fresh = as<EntityIndex>(count - recycled);
+        const auto first = m_commands.reserveIndices(fresh);
+        for (auto index : range(first, first + fresh)) entities.emplace_back(entityHandle(index, 0));
+
+        if (fresh > 0 and first + fresh > std::size(m_slots)) m_slots.resize(first + fresh);
+
+        for (auto entity : entities) {
+            auto& slot = m_slots[entityIndex(entity)];
+            expects(slot.position == EntitySlot::FREE);
+
+            slot.position = EntitySlot::PENDING;
+        }
+
+        m_added_entities.insert(std::ranges::end(m_added_entities),
+                                std::ranges::begin(entities),
+                                std::ranges::end(entities));
+        m_message_bus.push(ADDED_ENTITY_MESSAGE_ID, entities);
+
+        return entities;
+    }
+
     /////////////////////////////////////
     /////////////////////////////////////
     auto EntityManager::destroyEntity(Entity entity) -> void {
         expects(entity != INVALID_ENTITY);
 
-        if (hasEntity(entity)) {
-            m_removed_entities.emplace(entity);
-            m_message_bus.push(Message { REMOVED_ENTITY_MESSAGE_ID, { entity } });
-        }
+        // an entity destroyed twice in the same frame is only reported once
+        if (hasEntity(entity) and m_removed_entities.emplace(entity).second)
+            m_message_bus.push(REMOVED_ENTITY_MESSAGE_ID, entity);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto EntityManager::destroyAllEntities() -> void {
-        for (auto&& e : entities()) {
-            m_removed_entities.emplace(e);
-            m_message_bus.push(Message { REMOVED_ENTITY_MESSAGE_ID, { e } });
+    auto EntityManager::reserveEntities(RangeExtent count) -> void {
+        m_slots.reserve(count + 1);
+        m_entities.reserve(count);
+        m_added_entities.reserve(count);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::destroyEntities(std::span<const Entity> entities) -> void {
+        m_removed_entities.reserve(std::size(m_removed_entities) + std::size(entities));
+
+        // the entities already destroyed this frame, or listed twice, are reported once
+        auto removed = std::vector<Entity> {};
+        removed.reserve(std::size(entities));
+        for (auto entity : entities) {
+            if (entity == INVALID_ENTITY or not hasEntity(entity)) continue;
+            if (m_removed_entities.emplace(entity).second) removed.emplace_back(entity);
         }
+
+        m_message_bus.push(REMOVED_ENTITY_MESSAGE_ID, removed);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto EntityManager::hasEntity(Entity entity) const -> bool {
-        expects(entity != INVALID_ENTITY);
+    auto EntityManager::destroyAllEntities() -> void {
+        m_removed_entities.reserve(std::size(m_entities) + std::size(m_added_entities));
+
+        // the entities already destroyed this frame were reported by their own message
+        auto removed = std::vector<Entity> {};
+        removed.reserve(std::size(m_entities) + std::size(m_added_entities));
+        const auto remove = [this, &removed](Entity entity) {
+            if (not hasEntity(entity)) return;
+            if (m_removed_entities.emplace(entity).second) removed.emplace_back(entity);
+        };
+        for (auto entity : m_entities) remove(entity);
+        for (auto entity : m_added_entities) remove(entity);
 
-        return std::ranges::any_of(entities(), monadic::is(entity))
-               or std::ranges::any_of(m_added_entities, monadic::is(entity));
+        if (not std::empty(removed)) m_message_bus.push(REMOVED_ENTITY_MESSAGE_ID, removed);
     }
 
     /////////////////////////////////////
@@ -79,51 +158,320 @@ namespace stormkit::entities {
     auto EntityManager::hasComponent(Entity entity, Component::Type type) const -> bool {
         expects(entity != INVALID_ENTITY and type != Component::INVALID_TYPE);
 
-        return std::ranges::any_of(m_registered_components_for_entities.at(entity),
-                                   monadic::is(type));
+        const auto it = m_component_ids.find(type);
+        if (it == std::ranges::cend(m_component_ids) or not hasEntity(entity)) return false;
+
+        return signature(entity).test(it->second);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
     auto EntityManager::step(Secondf delta) -> void {
-        for (auto entity : m_removed_entities) {
-            m_cached_entities_dirty = true;
+        const auto frame_tick = m_tick;
 
-            auto it = m_registered_components_for_entities.find(entity);
-            // a this point, all entities should be valid
-            ensures(it != std::ranges::cend(m_registered_components_for_entities));
+        m_commands.playback(*this);
 
-            for (auto&& key : it->second | std::views::transform([entity](auto&& type) {
-                                  return componentKeyFor(entity, type);
-                              }))
-                m_components.erase(key);
+        // removed entities are all alive, so if there is as much as alive entities every
+        // entity is going away
+        const auto releases_all = [this] {
+            const auto pending_count = std::ranges::count_if(m_added_entities, [this](auto entity) {
+                return hasEntity(entity);
+            });
+            return std::size(m_removed_entities) == std::size(m_entities) + pending_count;
+        };
+        if (not std::empty(m_removed_entities) and releases_all()) releaseAllEntities();
+        else
+            for (auto entity : m_removed_entities) releaseEntity(entity);
+        m_removed_entities.clear();
 
-            m_entities.erase(entity);
+        m_entities.reserve(std::size(m_entities) + std::size(m_added_entities));
+        for (auto entity : m_added_entities) {
+            // entity may have been destroyed in the same frame
+            if (not hasEntity(entity)) continue;
 
-            removeFromSystems(entity);
+            m_slots[entityIndex(entity)].position = as<UInt32>(std::size(m_entities));
+            m_entities.emplace_back(entity);
 
-            if (not std::ranges::any_of(m_added_entities, monadic::is(entity)))
-                m_free_entities.push(entity);
+            purposeToSystems(entity);
         }
-        m_removed_entities.clear();
-
-        if (not std::empty(m_added_entities)) m_cached_entities_dirty = true;
-        std::ranges::for_each(m_added_entities,
-                              [this](auto&& entity) { m_entities.emplace(entity); });
         m_added_entities.clear();
 
-        std::ranges::for_each(m_updated_entities,
-                              [this](auto&& entity) { purposeToSystems(entity); });
-        m_updated_entities.clear();
+        // only the systems interested in the changed component need to be checked again
+        for (auto [entity, id] : m_changed_components)
+            if (hasEntity(entity)) updateSystemsMembership(entity, id);
+        m_changed_components.clear();
+
+        m_message_bus.forEach([this](const Message& message) {
+            for (auto& system : m_systems)
+                if (system->isSubscribedTo(message.id)) system->onMessageReceived(message);
+        });
+        m_message_bus.clear();
+
+        runPhase(Phase::PreUpdate, delta);
+        runPhase(Phase::Update, delta);
+        runPhase(Phase::PostUpdate, delta);
+
+        // the removals are kept until every system had a chance to see them
+        auto seen_until = frame_tick - 1;
+        for (auto& system : m_systems) seen_until = std::min(seen_until, system->m_last_run_tick);
+        for (auto& pool : m_pools)
+            if (pool) pool->discardRemoved(seen_until);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::releaseEntity(Entity entity) -> void {
+        // a this point, all entities should be valid
+        ensures(hasEntity(entity));
+
+        removeFromSystems(entity);
 
-        while (!m_message_bus.empty()) {
-            for (auto& system : m_systems) system->onMessageReceived(m_message_bus.top());
-            m_message_bus.pop();
+        const auto index = entityIndex(entity);
+        auto&      slot  = m_slots[index];
+
+        slot.signature.forEach([this, entity](auto id) { m_pools[id]->remove(entity); });
+        slot.signature.clear();
+
+        if (slot.position != EntitySlot::PENDING) {
+            const auto last                     = m_entities.back();
+            m_entities[slot.position]           = last;
+            m_slots[entityIndex(last)].position = slot.position;
+            m_entities.pop_back();
         }
 
-        for (auto& system : m_systems) system->preUpdate();
-        for (auto& system : m_systems) system->update(delta);
-        for (auto& system : m_systems) system->postUpdate();
+        slot.generation += 1;
+        slot.position    = EntitySlot::FREE;
+
+        m_free_entities.push(index);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::releaseAllEntities() -> void {
+        // pools and systems are emptied in one go and keep their storage for the next spawn
+        for (auto& system : m_systems) system->m_entities.clear();
+        for (auto& pool : m_pools)
+            if (pool) pool->clear();
+
+        const auto release = [this](Entity entity) {
+            const auto index = entityIndex(entity);
+            auto&      slot  = m_slots[index];
+
+            slot.signature.clear();
+            slot.generation += 1;
+            slot.position    = EntitySlot::FREE;
+
+            m_free_entities.push(index);
+        };
+
+        // free the slots in storage order so the next spawn reuses them in the same order
+        for (auto entity : m_entities) release(entity);
+        for (auto entity : m_added_entities)
+            if (hasEntity(entity)) release(entity);
+
+        m_entities.clear();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::setExecutionMode(ExecutionMode mode) -> void {
+        m_execution_mode = mode;
+
+        // the workers are created on demand, see threadPool()
+        if (m_execution_mode == ExecutionMode::Deterministic) m_thread_pool.reset();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::threadPool() const -> ThreadPool* {
+        if (m_execution_mode == ExecutionMode::Deterministic) return nullptr;
+
+        if (not m_thread_pool) [[unlikely]] {
+            // the calling thread takes part in parallelEach, keep a core for it
+            const auto worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+            m_thread_pool           = std::make_unique<ThreadPool>(as<Int>(worker_count));
+            m_thread_pool->setName("StormKit:EntitiesWorker");
+        }
+
+        return m_thread_pool.get();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::buildSchedule() -> void {
+        auto schedule    = Schedule {};
+        schedule.systems = systems();
+
+        const auto count = as<UInt32>(std::size(schedule.systems));
+        schedule.successors.resize(count);
+        schedule.predecessor_counts.resize(count, 0u);
+
+        // m_systems is sorted by priority, so conflicting systems keep their serial order
+        for (auto i : range(count)) {
+            for (auto j = i + 1u; j < count; ++j) {
+                if (not schedule.systems[i]->conflictsWith(*schedule.systems[j])) {
+                    schedule.concurrent = true;
+                    continue;
+                }
+
+                schedule.successors[i].emplace_back(j);
+                schedule.predecessor_counts[j] += 1;
+            }
+
+            if (schedule.predecessor_counts[i] == 0) schedule.roots.emplace_back(i);
+        }
+
+        m_schedule = std::move(schedule);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::runPhase(Phase phase, Secondf delta) -> void {
+        const auto count      = as<UInt32>(std::size(m_systems));
+        const auto first_tick = m_tick + 1;
+
+        // every system run gets its own tick, so a change is seen exactly once by each system,
+        // the ones made between two phases or outside step() are stamped with m_tick
+        const auto finish = [this, first_tick, count] noexcept {
+            m_tick = first_tick + count;
+            for (auto& pool : m_pools)
+                if (pool) pool->setTick(m_tick);
+        };
+
+        // the pools written by the system are only touched by it while it runs
+        const auto run = [this, phase, delta, first_tick](System& system, UInt32 index) {
+            const auto tick = first_tick + index;
+            if (system.m_exclusive) {
+                for (auto& pool : m_pools)
+                    if (pool) pool->setTick(tick);
+            } else
+                system.m_write_signature.forEach([this, tick](auto id) {
+                    if (m_pools[id]) m_pools[id]->setTick(tick);
+                });
+
+            switch (phase) {
+                case Phase::PreUpdate: system.preUpdate(); break;
+                case Phase::Update:
+                    system.update(delta);
+                    system.m_last_run_tick = tick;
+                    break;
+                case Phase::PostUpdate: system.postUpdate(); break;
+            }
+        };
+        const auto run_serially = [this, &run, &finish] {
+            auto index = 0u;
+            for (auto& system : m_systems) run(*system, index++);
+            finish();
+        };
+
+        if (m_execution_mode == ExecutionMode::Deterministic or count < 2) {
+            run_serially();
+            return;
+        }
+
+        if (not m_schedule) buildSchedule();
+
+        const auto& schedule = *m_schedule;
+
+        // nothing can overlap, the dependency graph is the priority order
+        if (not schedule.concurrent) {
+            run_serially();
+            return;
+        }
+
+        // created before any system runs, so they can call threadPool() concurrently
+        auto& workers = *threadPool();
+
+        auto pending = std::make_unique<std::atomic<UInt32>[]>(count);
+        for (auto i : range(count))
+            pending[i].store(schedule.predecessor_counts[i], std::memory_order_relaxed);
+
+        auto remaining = std::atomic<RangeExtent> { count };
+        auto error     = std::exception_ptr {};
+        auto mutex     = std::mutex {};
+        auto done      = std::condition_variable {};
+        auto finished  = false;
+        // exclusive systems made ready by a worker, run by the calling thread
+        auto handed_over = std::vector<UInt32> {};
+
+        constexpr auto NO_SYSTEM = std::numeric_limits<UInt32>::max();
+
+        // run `first` then keep going with one of the systems it made ready, the others are
+        // posted to the workers, so a chain of conflicting systems stays on the same thread
+        const auto execute = [&](this const auto& self, UInt32 first, bool on_calling_thread)
+            -> void {
+            for (auto index = first; index != NO_SYSTEM;) {
+                try {
+                    run(*schedule.systems[index], index);
+                } catch (...) {
+                    auto lock = std::scoped_lock { mutex };
+                    if (not error) error = std::current_exception();
+                }
+
+                auto next = NO_SYSTEM;
+                for (auto successor : schedule.successors[index]) {
+                    if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+
+                    if (schedule.systems[successor]->isExclusive() and not on_calling_thread) {
+                        auto lock = std::scoped_lock { mutex };
+                        handed_over.emplace_back(successor);
+                        done.notify_one();
+                    } else if (next == NO_SYSTEM) next = successor;
+                    else
+                        workers.postTask<void>([&self, successor] { self(successor, false); },
+                                               ThreadPool::NoFuture);
+                }
+
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    // notify under the lock, the waiting thread owns all these locals
+                    auto lock = std::scoped_lock { mutex };
+                    finished  = true;
+                    done.notify_one();
+                }
+
+                index = next;
+            }
+        };
+
+        // an exclusive root is the only root, the calling thread takes the first one
+        for (auto root : schedule.roots | std::views::drop(1))
+            workers.postTask<void>([&execute, root] { execute(root, false); },
+                                   ThreadPool::NoFuture);
+        execute(schedule.roots.front(), true);
+
+        for (;;) {
+            auto lock = std::unique_lock { mutex };
+            done.wait(lock, [&finished, &handed_over] noexcept {
+                return finished or not std::empty(handed_over);
+            });
+            if (finished) break;
+
+            const auto index = handed_over.back();
+            handed_over.pop_back();
+            lock.unlock();
+
+            execute(index, true);
+        }
+
+        finish();
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::registerSystem(System& system) -> void {
+        system.m_signature.clear();
+        for (auto type : system.componentsUsed()) {
+            const auto id = componentId(type);
+            system.m_signature.set(id);
+            m_systems_by_component[id].emplace_back(borrowMut(system));
+        }
+
+        system.m_write_signature.clear();
+        for (auto type : system.componentsWritten()) system.m_write_signature.set(componentId(type));
+
+        getNeededEntities(system);
     }
 
     /////////////////////////////////////
@@ -131,15 +479,22 @@ namespace stormkit::entities {
     auto EntityManager::purposeToSystems(Entity e) -> void {
         expects(e != INVALID_ENTITY);
 
-        const auto reliable_system_filter = [e, this](auto&& system) {
-            for (auto component_type : system->componentsUsed())
-                if (not hasComponent(e, component_type)) return false;
+        const auto& entity_signature = signature(e);
+        for (auto& system : m_systems)
+            if (entity_signature.contains(system->m_signature)) system->addEntity(e);
+    }
 
-            return true;
-        };
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::updateSystemsMembership(Entity e, ComponentId id) -> void {
+        expects(e != INVALID_ENTITY);
 
-        std::ranges::for_each(systems() | std::views::filter(reliable_system_filter),
-                              [e](auto&& system) { system->addEntity(e); });
+        const auto& entity_signature = signature(e);
+        for (auto& system : m_systems_by_component[id]) {
+            if (entity_signature.contains(system->m_signature)) system->addEntity(e);
+            else
+                system->removeEntity(e);
+        }
     }
 
     /////////////////////////////////////
@@ -147,20 +502,29 @@ namespace stormkit::entities {
     auto EntityManager::removeFromSystems(Entity e) -> void {
         expects(e != INVALID_ENTITY);
 
-        for (auto& s : m_systems) { s->removeEntity(e); }
+        // the signature may have changed since the last membership update
+        for (auto& system : m_systems) system->removeEntity(e);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
     auto EntityManager::getNeededEntities(System& system) -> void {
-        const auto reliable_entity_filter = [&system, this](auto&& entity) {
-            for (auto component_type : system.componentsUsed())
-                if (not hasComponent(entity, component_type)) return false;
+        for (auto entity : m_entities)
+            if (signature(entity).contains(system.m_signature)) system.addEntity(entity);
+    }
 
-            return true;
-        };
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::componentId(Component::Type type) -> ComponentId {
+        expects(type != Component::INVALID_TYPE);
+
+        const auto [it, inserted]
+            = m_component_ids.try_emplace(type, as<ComponentId>(std::size(m_pools)));
+        if (inserted) [[unlikely]] {
+            m_pools.emplace_back();
+            m_systems_by_component.emplace_back();
+        }
 
-        std::ranges::for_each(entities() | std::views::filter(reliable_entity_filter),
-                              [&system](auto&& e) { system.addEntity(e); });
+        return it->second;
     }
 } // namespace stormkit::entities
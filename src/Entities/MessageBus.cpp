@@ -27,19 +27,45 @@ namespace stormkit::entities {
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto MessageBus::push(Message&& message) -> void {
-        m_messages.emplace(std::move(message));
+    auto MessageBus::push(UInt32 id, Entity entity) -> void {
+        channel(id).entities.emplace_back(entity);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto MessageBus::top() const -> const Message& {
-        return m_messages.front();
+    auto MessageBus::push(UInt32 id, std::span<const Entity> entities) -> void {
+        if (std::empty(entities)) return;
+
+        auto& output = channel(id).entities;
+        output.insert(std::ranges::end(output),
+                      std::ranges::begin(entities),
+                      std::ranges::end(entities));
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto MessageBus::push(const Message& message) -> void {
+        push(message.id, message.entities);
     }
 
     /////////////////////////////////////
     /////////////////////////////////////
-    auto MessageBus::pop() -> void {
-        m_messages.pop();
+    auto MessageBus::clear() noexcept -> void {
+        for (auto index : m_pending_channels) m_channels[index].entities.clear();
+        m_pending_channels.clear();
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto MessageBus::channel(UInt32 id) -> Channel& {
+        // only a handful of message ids are in use, a linear search beats hashing here
+        auto it = std::ranges::find(m_channels, id, &Channel::id);
+        if (it == std::ranges::end(m_channels)) [[unlikely]]
+            it = m_channels.insert(std::ranges::end(m_channels), Channel { id, {} });
+
+        if (std::empty(it->entities))
+            m_pending_channels.emplace_back(std::distance(std::ranges::begin(m_channels), it));
+
+        return *it;
     }
 } // namespace stormkit::entities
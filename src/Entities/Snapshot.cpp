@@ -0,0 +1,440 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+module;
+
+#include <stormkit/Core/PlatformMacro.hpp>
+
+#ifdef STORMKIT_OS_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+module stormkit.Entities;
+
+import std;
+
+import stormkit.Core;
+
+namespace stormkit::entities {
+    namespace {
+        /// Sequential writer keeping track of the offset to align the sections
+        class SnapshotWriter {
+          public:
+            explicit SnapshotWriter(std::ostream& stream) noexcept : m_stream { stream } {}
+
+            auto write(std::span<const Byte> data) -> void {
+                core::write(m_stream, data);
+                m_offset += std::size(data);
+            }
+
+            /// Write a section and pad it to the next SNAPSHOT_ALIGNMENT boundary
+            auto writeSection(std::span<const Byte> data) -> void {
+                write(data);
+
+                static constexpr auto PADDING = std::array<Byte, SNAPSHOT_ALIGNMENT> {};
+                const auto            padding = (SNAPSHOT_ALIGNMENT - m_offset % SNAPSHOT_ALIGNMENT)
+                                     % SNAPSHOT_ALIGNMENT;
+                write(std::span { PADDING }.first(padding));
+            }
+
+            template<class T>
+            auto writeSection(const T& value) -> void {
+                writeSection(std::as_bytes(std::span { &value, 1 }));
+            }
+
+            [[nodiscard]] auto good() const noexcept -> bool { return m_stream.good(); }
+
+          private:
+            std::ostream& m_stream;
+            RangeExtent   m_offset = 0;
+        };
+
+        /// Sequential reader over the snapshot bytes, sections are read in place
+        class SnapshotReader {
+          public:
+            explicit SnapshotReader(std::span<const Byte> data) noexcept : m_data { data } {}
+
+            template<class T>
+            [[nodiscard]] auto readValue() noexcept -> std::optional<T> {
+                const auto bytes = readBytes(sizeof(T));
+                if (not bytes) return std::nullopt;
+
+                auto value = T {};
+                std::memcpy(&value, std::data(*bytes), sizeof(T));
+
+                return value;
+            }
+
+            /// Returns `count` elements of `T` in place, the section is aligned so the elements
+            /// are too
+            template<class T>
+            [[nodiscard]] auto readSection(UInt64 count) noexcept
+                -> std::optional<std::span<const T>> {
+                if (count > std::size(m_data) / sizeof(T)) return std::nullopt;
+
+                const auto bytes = readBytes(count * sizeof(T));
+                if (not bytes) return std::nullopt;
+
+                return std::span { std::bit_cast<const T*>(std::data(*bytes)), count };
+            }
+
+            [[nodiscard]] auto readBytes(UInt64 size) noexcept
+                -> std::optional<std::span<const Byte>> {
+                if (size > std::size(m_data)) return std::nullopt;
+
+                const auto padded = (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT
+                                    * SNAPSHOT_ALIGNMENT;
+                if (std::size(m_data) < padded) return std::nullopt;
+
+                const auto bytes = m_data.first(size);
+                m_data           = m_data.subspan(padded);
+
+                return bytes;
+            }
+
+          private:
+            std::span<const Byte> m_data;
+        };
+
+        /// Read only mapping of a whole file
+        class MappedFile {
+          public:
+            MappedFile() noexcept = default;
+
+            ~MappedFile() {
+                if (std::data(m_data) == nullptr) return;
+#ifdef STORMKIT_OS_WINDOWS
+                ::UnmapViewOfFile(std::data(m_data));
+#else
+                ::munmap(const_cast<Byte*>(std::data(m_data)), std::size(m_data));
+#endif
+            }
+
+            MappedFile(const MappedFile&)                    = delete;
+            auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+            /// Returns nullptr on failure
+            [[nodiscard]] static auto open(const std::filesystem::path& filepath) noexcept
+                -> std::unique_ptr<MappedFile> {
+                auto file = std::make_unique<MappedFile>();
+#ifdef STORMKIT_OS_WINDOWS
+                const auto handle = ::CreateFileW(filepath.c_str(),
+                                                  GENERIC_READ,
+                                                  FILE_SHARE_READ,
+                                                  nullptr,
+                                                  OPEN_EXISTING,
+                                                  FILE_FLAG_SEQUENTIAL_SCAN,
+                                                  nullptr);
+                if (handle == INVALID_HANDLE_VALUE) return nullptr;
+
+                auto size = LARGE_INTEGER {};
+                if (not ::GetFileSizeEx(handle, &size) or size.QuadPart == 0) {
+                    ::CloseHandle(handle);
+                    return nullptr;
+                }
+
+                const auto mapping
+                    = ::CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                ::CloseHandle(handle);
+                if (mapping == nullptr) return nullptr;
+
+                const auto view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                ::CloseHandle(mapping);
+                if (view == nullptr) return nullptr;
+
+                file->m_data = { static_cast<const Byte*>(view), as<RangeExtent>(size.QuadPart) };
+#else
+                const auto fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) return nullptr;
+
+                struct stat status;
+                if (::fstat(fd, &status) != 0 or status.st_size == 0) {
+                    ::close(fd);
+                    return nullptr;
+                }
+
+                const auto size = as<RangeExtent>(status.st_size);
+                const auto view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (view == MAP_FAILED) return nullptr;
+
+                // the whole file is read once, front to back
+                ::madvise(view, size, MADV_SEQUENTIAL);
+                ::madvise(view, size, MADV_WILLNEED);
+
+                file->m_data = { static_cast<const Byte*>(view), size };
+#endif
+                return file;
+            }
+
+            [[nodiscard]] auto data() const noexcept -> std::span<const Byte> { return m_data; }
+
+          private:
+            std::span<const Byte> m_data;
+        };
+
+        struct PoolRecord {
+            const ComponentSerializer* serializer;
+            Component::Type            type;
+            std::span<const Entity>    entities;
+            std::span<const Byte>      payload;
+        };
+
+        /// Checks that the alive entities and the free list reference distinct slots (the slot
+        /// 0 backs INVALID_ENTITY) with the saved generation, and that each pool owner is alive
+        /// and listed once in its pool. Returns the slots which are neither alive nor free (the
+        /// ones reserved by pending commands when the snapshot was saved).
+        auto validateEntities(std::span<const EntityGeneration> generations,
+                              std::span<const Entity>           alive,
+                              std::span<const EntityIndex>      free_list,
+                              std::span<const PoolRecord>       records)
+            -> std::optional<std::vector<EntityIndex>> {
+            enum class SlotState : UInt8 {
+                Unused,
+                Alive,
+                Free,
+            };
+
+            const auto slot_count = std::size(generations);
+            auto       states     = std::vector<SlotState>(slot_count, SlotState::Unused);
+
+            for (auto entity : alive) {
+                const auto index = entityIndex(entity);
+                if (index == 0 or index >= slot_count or states[index] != SlotState::Unused
+                    or generations[index] != entityGeneration(entity)) [[unlikely]]
+                    return std::nullopt;
+
+                states[index] = SlotState::Alive;
+            }
+
+            for (auto index : free_list) {
+                if (index == 0 or index >= slot_count or states[index] != SlotState::Unused)
+                    [[unlikely]]
+                    return std::nullopt;
+
+                states[index] = SlotState::Free;
+            }
+
+            // 1 + the index of the last record owning each slot
+            auto owners = std::vector<UInt32>(slot_count, 0u);
+            for (auto i : range(as<UInt32>(std::size(records)))) {
+                for (auto entity : records[i].entities) {
+                    const auto index = entityIndex(entity);
+                    if (index >= slot_count or states[index] != SlotState::Alive
+                        or generations[index] != entityGeneration(entity)
+                        or owners[index] == i + 1) [[unlikely]]
+                        return std::nullopt;
+
+                    owners[index] = i + 1;
+                }
+            }
+
+            auto unused = std::vector<EntityIndex> {};
+            for (auto index : range(1u, as<EntityIndex>(slot_count)))
+                if (states[index] == SlotState::Unused) unused.emplace_back(index);
+
+            return unused;
+        }
+    } // namespace
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::saveSnapshot(std::ostream& stream) const -> SnapshotExpected<void> {
+        auto alive = std::vector<Entity> {};
+        alive.reserve(std::size(m_entities) + std::size(m_added_entities));
+        alive.insert(std::ranges::end(alive), std::ranges::begin(m_entities), std::ranges::end(m_entities));
+        for (auto entity : m_added_entities)
+            if (hasEntity(entity)) alive.emplace_back(entity);
+
+        auto free_list = std::vector<EntityIndex> {};
+        free_list.reserve(std::size(m_free_entities));
+        for (auto queue = m_free_entities; not std::empty(queue); queue.pop())
+            free_list.emplace_back(queue.front());
+
+        auto pools = std::vector<std::pair<const ComponentPoolBase*, const ComponentSerializer*>> {};
+        for (const auto& pool : m_pools) {
+            if (not pool or pool->empty()) continue;
+
+            const auto it = m_serializers.find(pool->type());
+            if (it == std::ranges::cend(m_serializers)) [[unlikely]]
+                return std::unexpected { SnapshotError::UnknownComponent };
+
+            pools.emplace_back(pool.get(), &it->second);
+        }
+
+        auto writer = SnapshotWriter { stream };
+        writer.writeSection(SnapshotHeader { .slot_count   = std::size(m_slots),
+                                             .entity_count = std::size(alive),
+                                             .free_count   = std::size(free_list),
+                                             .pool_count   = std::size(pools) });
+
+        auto generations = m_slots
+                           | std::views::transform([](const auto& slot) static noexcept {
+                                 return slot.generation;
+                             })
+                           | std::ranges::to<std::vector>();
+        writer.writeSection(std::as_bytes(std::span { generations }));
+        writer.writeSection(std::as_bytes(std::span { alive }));
+        writer.writeSection(std::as_bytes(std::span { free_list }));
+
+        auto scratch = std::vector<Byte> {};
+        for (const auto& [pool, serializer] : pools) {
+            scratch.clear();
+            const auto payload = serializer->save(*pool, scratch);
+
+            writer.writeSection(SnapshotPoolHeader { .type           = pool->type(),
+                                                     .component_size = serializer->component_size,
+                                                     .count          = pool->size(),
+                                                     .payload_size   = std::size(payload) });
+            writer.writeSection(std::as_bytes(pool->entities()));
+            writer.writeSection(payload);
+        }
+
+        if (not writer.good()) [[unlikely]]
+            return std::unexpected { SnapshotError::FileError };
+
+        return {};
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::saveSnapshot(const std::filesystem::path& filepath) const
+        -> SnapshotExpected<void> {
+        auto stream = std::ofstream { filepath, std::ios::binary | std::ios::trunc };
+        if (not stream) [[unlikely]]
+            return std::unexpected { SnapshotError::FileError };
+
+        return saveSnapshot(stream);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::loadSnapshot(std::span<const Byte> data) -> SnapshotExpected<void> {
+        expects(std::bit_cast<std::uintptr_t>(std::data(data)) % alignof(Entity) == 0);
+
+        // validate the whole snapshot before touching the EntityManager, only the component
+        // payloads are left to their serializer
+        auto reader = SnapshotReader { data };
+
+        const auto header = reader.readValue<SnapshotHeader>();
+        if (not header) [[unlikely]]
+            return std::unexpected { SnapshotError::Truncated };
+        if (header->magic != SNAPSHOT_MAGIC) [[unlikely]]
+            return std::unexpected { SnapshotError::InvalidMagic };
+        if (header->version != SNAPSHOT_VERSION) [[unlikely]]
+            return std::unexpected { SnapshotError::UnsupportedVersion };
+
+        if (header->slot_count > std::numeric_limits<EntityIndex>::max()) [[unlikely]]
+            return std::unexpected { SnapshotError::InvalidEntity };
+
+        const auto generations = reader.readSection<EntityGeneration>(header->slot_count);
+        const auto alive       = reader.readSection<Entity>(header->entity_count);
+        const auto free_list   = reader.readSection<EntityIndex>(header->free_count);
+        if (not generations or not alive or not free_list) [[unlikely]]
+            return std::unexpected { SnapshotError::Truncated };
+
+        // pool_count is not trusted for a reservation, the loop fails on the first missing pool
+        auto records = std::vector<PoolRecord> {};
+        for ([[maybe_unused]] auto _ : range(header->pool_count)) {
+            const auto pool_header = reader.readValue<SnapshotPoolHeader>();
+            if (not pool_header) [[unlikely]]
+                return std::unexpected { SnapshotError::Truncated };
+
+            const auto it = m_serializers.find(pool_header->type);
+            if (it == std::ranges::cend(m_serializers)) [[unlikely]]
+                return std::unexpected { SnapshotError::UnknownComponent };
+            if (it->second.component_size != pool_header->component_size) [[unlikely]]
+                return std::unexpected { SnapshotError::ComponentSizeMismatch };
+            if (std::ranges::contains(records, pool_header->type, &PoolRecord::type)) [[unlikely]]
+                return std::unexpected { SnapshotError::DuplicatedComponent };
+
+            const auto entities = reader.readSection<Entity>(pool_header->count);
+            const auto payload  = reader.readBytes(pool_header->payload_size);
+            if (not entities or not payload) [[unlikely]]
+                return std::unexpected { SnapshotError::Truncated };
+
+            records.emplace_back(&it->second, pool_header->type, *entities, *payload);
+        }
+
+        const auto unused = validateEntities(*generations, *alive, *free_list, records);
+        if (not unused) [[unlikely]]
+            return std::unexpected { SnapshotError::InvalidEntity };
+
+        // the pending messages are dropped and the previous entities are reported right away, so
+        // the ADDED batch of the loaded entities comes before any message pushed after the load,
+        // even if they reuse the same handles
+        m_message_bus.clear();
+        const auto removed = Message { REMOVED_ENTITY_MESSAGE_ID, m_entities };
+        for (auto& system : m_systems)
+            if (system->isSubscribedTo(removed.id)) system->onMessageReceived(removed);
+
+        // drop the current content, the entities created this frame were never reported and
+        // the pending commands may target indices reserved before the load
+        m_commands.clear();
+        m_added_entities.clear();
+        m_removed_entities.clear();
+        m_changed_components.clear();
+        for (auto& system : m_systems) system->m_entities.clear();
+        for (auto& pool : m_pools)
+            if (pool) pool->clear();
+
+        // the slot 0 backs INVALID_ENTITY and is always present
+        m_slots.assign(std::max<RangeExtent>(std::size(*generations), 1), EntitySlot {});
+        for (auto&& [slot, generation] : std::views::zip(m_slots, *generations))
+            slot.generation = generation;
+
+        m_entities.assign(std::ranges::begin(*alive), std::ranges::end(*alive));
+        for (auto i : range(as<UInt32>(std::size(m_entities))))
+            m_slots[entityIndex(m_entities[i])].position = i;
+
+        // the unused slots are recycled after the saved free list, so none of them is lost
+        m_free_entities = {};
+        for (auto index : *free_list) m_free_entities.push(index);
+        for (auto index : *unused) m_free_entities.push(index);
+
+        // new indices must not collide with the loaded slots
+        m_commands.m_next_index.store(as<EntityIndex>(std::max<RangeExtent>(std::size(m_slots), 1)),
+                                      std::memory_order_relaxed);
+
+        for (const auto& record : records) {
+            const auto id   = componentId(record.type);
+            auto&      pool = m_pools[id];
+            if (not pool) {
+                pool = record.serializer->make_pool(id);
+                pool->setTick(m_tick);
+            }
+
+            // the previous content is already gone, rather than a partially loaded world the
+            // EntityManager is left empty if a serializer rejects its payload
+            if (not record.serializer->load(*pool, record.entities, record.payload)) [[unlikely]] {
+                releaseAllEntities();
+                return std::unexpected { SnapshotError::InvalidPayload };
+            }
+
+            for (auto entity : record.entities) signature(entity).set(id);
+        }
+
+        for (auto& system : m_systems) getNeededEntities(*system);
+
+        m_message_bus.push(ADDED_ENTITY_MESSAGE_ID, m_entities);
+
+        return {};
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto EntityManager::loadSnapshot(const std::filesystem::path& filepath)
+        -> SnapshotExpected<void> {
+        const auto file = MappedFile::open(filepath);
+        if (not file) [[unlikely]]
+            return std::unexpected { SnapshotError::FileError };
+
+        return loadSnapshot(file->data());
+    }
+} // namespace stormkit::entities
@@ -12,7 +12,21 @@ namespace stormkit::entities {
     /////////////////////////////////////
     /////////////////////////////////////
     System::System(EntityManager& manager, UInt32 priority, ComponentTypes types)
-        : m_manager { borrow(manager) }, m_priority { priority }, m_types { std::move(types) } {
+        : m_manager { borrow(manager) }, m_priority { priority }, m_types { std::move(types) },
+          m_exclusive { true } {
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    System::System(EntityManager& manager,
+                   UInt32         priority,
+                   ComponentTypes reads,
+                   ComponentTypes writes)
+        : m_manager { borrow(manager) }, m_priority { priority }, m_reads { std::move(reads) },
+          m_writes { std::move(writes) }, m_exclusive { false } {
+        m_types.reserve(std::size(m_reads) + std::size(m_writes));
+        m_types.insert(std::ranges::begin(m_reads), std::ranges::end(m_reads));
+        m_types.insert(std::ranges::begin(m_writes), std::ranges::end(m_writes));
     }
 
     /////////////////////////////////////
@@ -37,6 +51,26 @@ namespace stormkit::entities {
     auto System::postUpdate() -> void {
     }
 
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto System::conflictsWith(const System& other) const noexcept -> bool {
+        if (m_exclusive or other.m_exclusive) return true;
+
+        const auto writes_any_of = [](const ComponentTypes& writes, const ComponentTypes& types) {
+            return std::ranges::any_of(types, [&writes](auto type) { return writes.contains(type); });
+        };
+
+        return writes_any_of(m_writes, other.m_reads)
+               or writes_any_of(m_writes, other.m_writes)
+               or writes_any_of(other.m_writes, m_reads);
+    }
+
+    /////////////////////////////////////
+    /////////////////////////////////////
+    auto System::subscribe(std::initializer_list<UInt32> message_ids) -> void {
+        m_subscriptions = std::vector<UInt32> { message_ids };
+    }
+
     /////////////////////////////////////
     /////////////////////////////////////
     auto System::addEntity(Entity e) -> void {
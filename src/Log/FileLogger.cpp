@@ -9,10 +9,22 @@ import std;
 import stormkit.Core;
 
 using namespace std::literals;
+using namespace stormkit::literals;
 
 namespace {
     constexpr auto LOG_FILE_NAME = "log.txt";
-}
+
+    /// `log.txt` for the default module, `<module>-log.txt` otherwise
+    auto logFilePath(const std::filesystem::path& base_path, std::string_view module_name)
+        -> std::filesystem::path {
+        if (std::empty(module_name)) return base_path / stormkit::toNativeEncoding(LOG_FILE_NAME);
+
+        auto filepath = base_path / stormkit::toNativeEncoding(module_name);
+        filepath += stormkit::toNativeEncoding("-") + stormkit::toNativeEncoding(LOG_FILE_NAME);
+
+        return filepath;
+    }
+} // namespace
 
 namespace stormkit::log {
     ////////////////////////////////////////
@@ -24,8 +36,7 @@ namespace stormkit::log {
 
         expects(std::filesystem::is_directory(m_base_path), "path need to be a directory");
 
-        auto filepath                = m_base_path / toNativeEncoding(LOG_FILE_NAME);
-        m_streams[filepath.string()] = std::ofstream { filepath.string() };
+        m_streams.emplace(""_hash, logFilePath(m_base_path, ""));
     }
 
     ////////////////////////////////////////
@@ -39,8 +50,7 @@ namespace stormkit::log {
 
         expects(std::filesystem::is_directory(m_base_path), "path need to be a directory");
 
-        auto filepath                = m_base_path / toNativeEncoding(LOG_FILE_NAME);
-        m_streams[filepath.string()] = std::ofstream { filepath.string() };
+        m_streams.emplace(""_hash, logFilePath(m_base_path, ""));
     }
 
     ////////////////////////////////////////
@@ -58,7 +68,7 @@ namespace stormkit::log {
     ////////////////////////////////////////
     ////////////////////////////////////////
     auto FileLogger::flush() -> void {
-        for (auto& [path, stream] : m_streams) stream.flush();
+        for (auto [path, stream] : m_streams) stream.flush();
     }
 
     ////////////////////////////////////////
@@ -70,14 +80,11 @@ namespace stormkit::log {
         const auto time
             = std::chrono::duration_cast<std::chrono::seconds>(now - m_start_time).count();
 
-        auto filepath = m_base_path / std::filesystem::path { toNativeEncoding(LOG_FILE_NAME) };
-        if (not std::empty(m.name)) {
-            filepath = m_base_path / toNativeEncoding(m.name);
-            filepath += toNativeEncoding("-") + toNativeEncoding(LOG_FILE_NAME);
-
-            if (m_streams.find(filepath.string()) == m_streams.cend())
-                m_streams[filepath.string()] = std::ofstream { filepath.string() };
-        }
+        // the streams are keyed by module name, the module file is opened on its first line
+        const auto key    = std::empty(m.name) ? ""_hash : HashedString { m.name };
+        auto*      stream = m_streams.find(key);
+        if (stream == nullptr) [[unlikely]]
+            stream = &m_streams.emplace(key, logFilePath(m_base_path, m.name)).first;
 
         static constexpr auto LOG_LINE        = "[{}, {}] {}\n"sv;
         static constexpr auto LOG_LINE_MODULE = "[{}, {}, {}] {}\n"sv;
@@ -88,6 +95,6 @@ namespace stormkit::log {
         else
             final_string = std::format(LOG_LINE_MODULE, toString(severity), time, m.name, string);
 
-        m_streams.at(filepath.string()) << final_string << std::flush;
+        *stream << final_string << std::flush;
     }
 } // namespace stormkit::log
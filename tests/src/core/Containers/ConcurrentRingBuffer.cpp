@@ -0,0 +1,123 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    constexpr auto VALUE_COUNT = Int64 { 100'000 };
+
+    auto _ = test::TestSuite {
+        "Core.Containers",
+        {
+          { "SPSCRingBuffer.order",
+              [] static {
+                  auto buffer = SPSCRingBuffer<Int64> { 100 };
+                  expects(buffer.capacity() == 128);
+
+                  auto producer = std::jthread { [&buffer] {
+                      for (auto value = Int64 { 0 }; value < VALUE_COUNT;) {
+                          if (value % 3 == 0) {
+                              auto values = std::array<Int64, 7> {};
+                              std::ranges::iota(values, value);
+                              const auto count = std::min<Int64>(7, VALUE_COUNT - value);
+                              value += as<Int64>(buffer.tryPushBatch(std::span { values }.first(
+                                  as<RangeExtent>(count))));
+                          } else if (buffer.tryPush(value))
+                              ++value;
+                      }
+                  } };
+
+                  auto ordered  = true;
+                  auto expected = Int64 { 0 };
+                  auto values   = std::array<Int64, 5> {};
+                  while (expected < VALUE_COUNT) {
+                      if (expected % 2 == 0) {
+                          const auto count = buffer.tryPopBatch(values);
+                          for (auto i : range(count)) ordered = ordered and values[i] == expected++;
+                      } else if (const auto value = buffer.tryPop(); value)
+                          ordered = ordered and *value == expected++;
+                  }
+                  expects(ordered);
+                  expects(buffer.empty());
+              } },
+          { "MPMCRingBuffer.sum",
+              [] static {
+                  static constexpr auto THREAD_COUNT = 3;
+
+                  auto buffer = MPMCRingBuffer<Int64> { 64 };
+                  auto sum    = std::atomic<Int64> { 0 };
+                  auto popped = std::atomic<Int64> { 0 };
+                  {
+                      auto threads = std::vector<std::jthread> {};
+                      for (auto _ : range(THREAD_COUNT))
+                          threads.emplace_back([&buffer] {
+                              for (auto value = Int64 { 0 }; value < VALUE_COUNT;)
+                                  if (buffer.tryPush(value)) ++value;
+                          });
+                      for (auto _ : range(THREAD_COUNT))
+                          threads.emplace_back([&buffer, &sum, &popped] {
+                              auto values = std::array<Int64, 6> {};
+                              while (popped.load() < VALUE_COUNT * THREAD_COUNT) {
+                                  const auto count = buffer.tryPopBatch(values);
+                                  for (auto i : range(count)) sum += values[i];
+                                  popped += as<Int64>(count);
+                              }
+                          });
+                  }
+
+                  expects(popped == VALUE_COUNT * THREAD_COUNT);
+                  expects(sum == THREAD_COUNT * (VALUE_COUNT * (VALUE_COUNT - 1) / 2));
+                  expects(buffer.empty());
+              } },
+          { "MPMCRingBuffer.destroy",
+              [] static {
+                  auto buffer = MPMCRingBuffer<std::string> { 4 };
+                  expects(buffer.tryPush(std::string(64, 'a')));
+                  expects(buffer.tryPush("b"));
+                  expects(buffer.tryPop() == std::string(64, 'a'));
+                  expects(buffer.size() == 1);
+              } },
+          { "MPMCRingBuffer.emptyBatch",
+              [] static {
+                  auto buffer = MPMCRingBuffer<Int64> { 4 };
+                  expects(buffer.tryPushBatch({}) == 0);
+                  expects(buffer.tryPopBatch({}) == 0);
+
+                  // same with a non empty buffer
+                  expects(buffer.tryPush(1));
+                  expects(buffer.tryPushBatch({}) == 0);
+                  expects(buffer.tryPopBatch({}) == 0);
+                  expects(buffer.size() == 1);
+              } },
+          { "BlockingRingBuffer.close",
+              [] static {
+                  auto buffer = BlockingSPSCRingBuffer<Int64> { 4 };
+                  auto sum    = Int64 { 0 };
+
+                  auto consumer = std::jthread { [&buffer, &sum] {
+                      auto values = std::array<Int64, 3> {};
+                      while (const auto count = buffer.popBatch(values))
+                          for (auto i : range(count)) sum += values[i];
+                  } };
+
+                  auto values = std::vector<Int64>(1'000);
+                  std::ranges::iota(values, 0);
+                  expects(buffer.pushBatch(values) == std::size(values));
+
+                  buffer.close();
+                  consumer.join();
+                  expects(sum == 999 * 1'000 / 2);
+                  expects(not buffer.push(1));
+              } },
+          }
+    };
+} // namespace
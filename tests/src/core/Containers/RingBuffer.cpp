@@ -0,0 +1,79 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    auto _ = test::TestSuite {
+        "Core.Containers",
+        {
+          { "RingBuffer.push",
+              [] static {
+                  auto buffer = RingBuffer<Int32> { 3 };
+                  for (auto i : range(5)) buffer.push(i);
+
+                  expects(buffer.full());
+                  expects(buffer.get() == 2);
+                  buffer.pop();
+                  expects(buffer.get() == 3);
+                  buffer.pop();
+                  expects(buffer.get() == 4);
+                  buffer.pop();
+                  expects(buffer.empty());
+              } },
+          { "RingBuffer.batch",
+              [] static {
+                  auto buffer = RingBuffer<Int32> { 8 };
+                  buffer.push(-1);
+                  buffer.pop();
+
+                  auto values = std::array<Int32, 10> {};
+                  std::ranges::iota(values, 0);
+                  buffer.pushBatch(values);
+                  expects(buffer.size() == 8);
+
+                  auto output = std::array<Int32, 5> {};
+                  expects(buffer.popBatch(output) == 5);
+                  expects(std::ranges::equal(output, std::array { 2, 3, 4, 5, 6 }));
+                  expects(buffer.popBatch(output) == 3);
+                  expects(
+                    std::ranges::equal(std::span { output }.first(3), std::array { 7, 8, 9 }));
+                  expects(buffer.empty());
+              } },
+          { "RingBuffer.copy",
+              [] static {
+                  auto buffer = RingBuffer<std::string> { 5 };
+                  for (auto i : range(7)) buffer.push(std::to_string(i));
+
+                  auto copy = buffer;
+                  buffer.clear();
+                  expects(buffer.empty());
+                  expects(copy.size() == 5);
+                  for (auto i : range(2, 7)) {
+                      expects(copy.get() == std::to_string(i));
+                      copy.pop();
+                  }
+              } },
+          { "RingBuffer.clear",
+              [] static {
+                  auto buffer = RingBuffer<UInt64> { 4 };
+                  for (auto i : range(UInt64 { 6 })) buffer.push(i);
+
+                  buffer.clear();
+                  expects(buffer.empty());
+                  buffer.push(UInt64 { 42 });
+                  expects(buffer.size() == 1);
+                  expects(buffer.get() == 42);
+              } },
+        }
+    };
+} // namespace
@@ -14,13 +14,153 @@ using namespace std::literals;
 #define expects(x) test::expects(x, #x)
 
 namespace {
-    auto _ = test::TestSuite { "Core.Containers", { { "Tree.Node.name", [] {
-                                                         static constexpr auto name
-                                                             = "TestNodeName"s;
-
-                                                         auto node = TreeNode {};
-                                                         expects(node.name() == ""s);
-                                                         node.setName(name);
-                                                         expects(node.name() == name);
-                                                     } } } };
+    using IndexType = TreeNode::IndexType;
+
+    auto insertNode(Tree<>& tree, std::string name, IndexType parent, IndexType previous)
+        -> IndexType {
+        auto node = TreeNode {};
+        node.setName(std::move(name));
+
+        return tree.insert(std::move(node), parent, previous);
+    }
+
+    /// root -> (a -> (a1, a2), b -> b1)
+    struct Nodes {
+        IndexType root;
+        IndexType a;
+        IndexType a1;
+        IndexType a2;
+        IndexType b;
+        IndexType b1;
+    };
+
+    auto makeTree(Tree<>& tree) -> Nodes {
+        auto nodes = Nodes {};
+        nodes.root = insertNode(tree, "root", TreeNode::INVALID_INDEX, TreeNode::INVALID_INDEX);
+        nodes.a    = insertNode(tree, "a", nodes.root, TreeNode::INVALID_INDEX);
+        nodes.b    = insertNode(tree, "b", nodes.root, nodes.a);
+        nodes.b1   = insertNode(tree, "b1", nodes.b, TreeNode::INVALID_INDEX);
+        nodes.a1   = insertNode(tree, "a1", nodes.a, TreeNode::INVALID_INDEX);
+        nodes.a2   = insertNode(tree, "a2", nodes.a, nodes.a1);
+
+        return nodes;
+    }
+
+    auto names(const Tree<>& tree, std::ranges::input_range auto&& indices)
+        -> std::vector<std::string> {
+        auto output = std::vector<std::string> {};
+        for (auto index : indices) output.emplace_back(tree[index].name());
+
+        return output;
+    }
+
+    auto _ = test::TestSuite {
+        "Core.Containers",
+        {
+          { "Tree.Node.name",
+              [] {
+                  static constexpr auto name = "TestNodeName"s;
+
+                  auto node = TreeNode {};
+                  expects(node.name() == ""s);
+                  node.setName(name);
+                  expects(node.name() == name);
+              } },
+          { "Tree.depthFirst",
+              [] {
+                  auto       tree  = Tree<> {};
+                  const auto nodes = makeTree(tree);
+
+                  const auto expected_tree
+                      = std::vector { "root"s, "a"s, "a1"s, "a2"s, "b"s, "b1"s };
+                  const auto expected_subtree = std::vector { "a"s, "a1"s, "a2"s };
+                  expects(names(tree, tree.depthFirst(nodes.root)) == expected_tree);
+                  expects(names(tree, tree.depthFirst(nodes.a)) == expected_subtree);
+                  expects(std::ranges::empty(tree.depthFirst(TreeNode::INVALID_INDEX)));
+              } },
+          { "Tree.breadthFirst",
+              [] {
+                  auto       tree  = Tree<> {};
+                  const auto nodes = makeTree(tree);
+
+                  const auto expected_tree
+                      = std::vector { "root"s, "a"s, "b"s, "a1"s, "a2"s, "b1"s };
+                  const auto expected_subtree = std::vector { "b"s, "b1"s };
+                  expects(names(tree, tree.breadthFirst(nodes.root)) == expected_tree);
+                  expects(names(tree, tree.breadthFirst(nodes.b)) == expected_subtree);
+              } },
+          { "Tree.compact",
+              [] {
+                  auto       tree  = Tree<> {};
+                  const auto nodes = makeTree(tree);
+                  tree.remove(nodes.a1);
+                  tree.markDirty(nodes.b1, 1);
+
+                  const auto remap = tree.compact();
+                  expects(remap[nodes.a1] == TreeNode::INVALID_INDEX);
+
+                  const auto root = remap[nodes.root];
+                  expects(root == IndexType { 0 });
+
+                  const auto expected = std::vector { "root"s, "a"s, "a2"s, "b"s, "b1"s };
+                  expects(names(tree, tree.depthFirst(root)) == expected);
+                  // the nodes are stored in depth first order
+                  const auto indices = range(IndexType::ID { 5 })
+                                       | std::views::transform(
+                                           [](IndexType::ID i) { return IndexType { i }; });
+                  expects(names(tree, indices) == expected);
+
+                  expects(std::size(tree.dirties()) == 1);
+                  expects(tree.dirties()[0] == remap[nodes.b1]);
+
+                  const auto c = insertNode(tree, "c", root, remap[nodes.b]);
+                  expects(c == IndexType { 5 });
+                  expects(names(tree, tree.depthFirst(root)).back() == "c"s);
+              } },
+          { "Tree.propagateDirties",
+              [] {
+                  auto       tree  = Tree<> {};
+                  const auto nodes = makeTree(tree);
+                  tree.markDirty(nodes.a, 0b01);
+                  tree.markDirty(nodes.a2, 0b10);
+                  tree.markDirty(nodes.b1, 0b10);
+
+                  tree.propagateDirties();
+                  expects(tree[nodes.root].dirtyBits() == 0);
+                  expects(tree[nodes.a1].dirtyBits() == 0b01);
+                  expects(tree[nodes.a2].dirtyBits() == 0b11);
+                  expects(tree[nodes.b].dirtyBits() == 0);
+                  expects(tree[nodes.b1].dirtyBits() == 0b10);
+                  expects(std::size(tree.dirties()) == 4);
+              } },
+          { "Tree.propagateDirties.parallel",
+              [] {
+                  static constexpr auto CHILD_COUNT = 64u;
+
+                  auto tree = Tree<> {};
+                  const auto root
+                      = insertNode(tree, "root", TreeNode::INVALID_INDEX, TreeNode::INVALID_INDEX);
+                  auto leaves = std::vector<IndexType> {};
+                  for (auto i : range(CHILD_COUNT)) {
+                      const auto child
+                          = insertNode(tree, std::to_string(i), root, TreeNode::INVALID_INDEX);
+                      for (auto j : range(CHILD_COUNT))
+                          leaves.emplace_back(
+                              insertNode(tree, std::to_string(j), child, TreeNode::INVALID_INDEX));
+                  }
+                  tree.markDirty(root, 0b01);
+                  tree.markDirty(leaves.front(), 0b10);
+
+                  auto pool = ThreadPool { 3 };
+                  tree.propagateDirties(pool);
+
+                  auto propagated = true;
+                  for (auto index : tree.depthFirst(root))
+                      propagated = propagated and (tree[index].dirtyBits() & 0b01);
+                  expects(propagated);
+                  expects(tree[leaves.front()].dirtyBits() == 0b11);
+                  expects(std::size(tree.dirties()) == 1 + CHILD_COUNT + CHILD_COUNT * CHILD_COUNT);
+              } },
+        }
+    };
 } // namespace
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    auto value(Int64 value) -> Task<Int64> {
+        co_return value;
+    }
+
+    auto chain(Int64 depth) -> Task<Int64> {
+        if (depth == 0) co_return 0;
+
+        co_return 1 + co_await chain(depth - 1);
+    }
+
+    auto failing() -> Task<> {
+        throw std::runtime_error { "" };
+        co_return;
+    }
+
+    auto doubleOnPool(ThreadPool& pool, Int64 value) -> Task<Int64> {
+        co_await pool.schedule();
+
+        co_return value * 2;
+    }
+
+    auto sumOnPool(ThreadPool& pool, Int64 count) -> Task<Int64> {
+        auto tasks = std::vector<Task<Int64>> {};
+        for (auto i : range(count)) tasks.emplace_back(doubleOnPool(pool, i));
+
+        const auto values = co_await whenAll(std::move(tasks));
+        co_return std::ranges::fold_left(values, Int64 { 0 }, std::plus {});
+    }
+
+    auto _ = test::TestSuite {
+        "Core.Coroutines",
+        {
+          { "Task.chain",
+              [] static {
+                  expects(syncWait(value(42)) == 42);
+                  expects(syncWait(chain(10'000)) == 10'000);
+              } },
+          { "Task.exception",
+              [] static {
+                  auto thrown = false;
+                  try {
+                      syncWait(failing());
+                  } catch (const std::runtime_error&) { thrown = true; }
+                  expects(thrown);
+              } },
+          { "Task.whenAll",
+              [] static {
+                  auto called = false;
+                  auto set    = [](bool& called) -> Task<> {
+                      called = true;
+                      co_return;
+                  };
+
+                  const auto results = syncWait(whenAll(value(1), value(2), set(called)));
+                  expects(std::get<0>(results) == 1);
+                  expects(std::get<1>(results) == 2);
+                  expects(called);
+
+                  auto thrown = false;
+                  try {
+                      syncWait(whenAll(value(1), failing()));
+                  } catch (const std::runtime_error&) { thrown = true; }
+                  expects(thrown);
+              } },
+          { "Task.schedule",
+              [] static {
+                  auto pool = ThreadPool { 3 };
+                  expects(syncWait(doubleOnPool(pool, 21)) == 42);
+                  expects(syncWait(sumOnPool(pool, 1'000)) == 999 * 1'000);
+              } },
+          { "Task.whenAny",
+              [] static {
+                  auto pool  = ThreadPool { 3 };
+                  auto tasks = std::vector<Task<Int64>> {};
+                  for (auto i : range(8)) tasks.emplace_back(doubleOnPool(pool, i));
+
+                  const auto result = syncWait(whenAny(std::move(tasks)));
+                  expects(result.index < 8);
+                  expects(result.value == as<Int64>(result.index) * 2);
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,94 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+using namespace stormkit::core::literals;
+using namespace std::literals;
+
+#define expects(x) test::expects(x, #x)
+
+static_assert(("name"_hash).hash == HashedString { "name"sv }.hash);
+static_assert(("name"_hash).hash != ("eman"_hash).hash);
+
+namespace {
+    /// longer than FlatStringHashMap::INLINE_KEY_CAPACITY
+    constexpr auto LONG_KEY = "logs/a-module-with-a-long-name-log.txt"sv;
+
+    auto _ = test::TestSuite {
+        "Core.Hash",
+        {
+          { "StringHash.runtime",
+              [] static {
+                  const auto name = "name"s;
+                  expects(StringHash {}(name) == ("name"_hash).hash);
+                  const auto other = "logs/b-module-with-a-long-name-log.txt"sv;
+                  expects(StringHash {}(LONG_KEY) != StringHash {}(other));
+              } },
+          { "FlatStringHashMap.emplace",
+              [] static {
+                  auto map = FlatStringHashMap<Int> {};
+                  expects(map.emplace("short", 1).second);
+                  expects(map.emplace(LONG_KEY, 2).second);
+                  expects(not map.emplace("short", 3).second);
+
+                  expects(std::size(map) == 2);
+                  expects(map.at("short") == 1);
+                  expects(map.at(std::string { LONG_KEY }) == 2);
+                  expects(*map.find("short"_hash) == 1);
+                  expects(map.find("missing") == nullptr);
+
+                  map["short"] = 4;
+                  map["other"] = 5;
+                  expects(map.at("short") == 4);
+                  expects(std::size(map) == 3);
+              } },
+          { "FlatStringHashMap.erase",
+              [] static {
+                  auto map = FlatStringHashMap<std::string> {};
+                  for (auto i : range(1'000)) map.emplace(std::to_string(i), std::to_string(i));
+
+                  for (auto i : range(0, 1'000, 2)) expects(map.erase(std::to_string(i)));
+                  expects(not map.erase("0"));
+                  expects(std::size(map) == 500);
+
+                  auto found = true;
+                  for (auto i : range(1'000)) {
+                      const auto* value = map.find(std::to_string(i));
+                      found = found and ((i % 2 == 0) == (value == nullptr));
+                      if (value) found = found and *value == std::to_string(i);
+                  }
+                  expects(found);
+              } },
+          { "FlatStringHashMap.iteration",
+              [] static {
+                  auto map = FlatStringHashMap<Int> { 16 };
+                  map.emplace("a", 1);
+                  map.emplace("b", 2);
+                  map.emplace(LONG_KEY, 3);
+
+                  auto copy = map;
+                  map.clear();
+                  expects(std::empty(map));
+
+                  auto sum  = Int { 0 };
+                  auto keys = std::vector<std::string_view> {};
+                  for (auto [key, value] : copy) {
+                      keys.emplace_back(key);
+                      sum += value;
+                  }
+                  std::ranges::sort(keys);
+
+                  const auto expected = std::vector { "a"sv, "b"sv, LONG_KEY };
+                  expects(keys == expected);
+                  expects(sum == 6);
+              } },
+        }
+    };
+} // namespace
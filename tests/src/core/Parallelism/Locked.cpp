@@ -13,6 +13,12 @@ using namespace stormkit::core;
 #define expects(x) test::expects(x, #x)
 
 namespace {
+    /// b == -a, readers check it to detect torn reads
+    struct Pair {
+        Int64 a = 0;
+        Int64 b = 0;
+    };
+
     auto _ = test::TestSuite {
         "Core.Parallelism",
         {
@@ -35,6 +41,81 @@ namespace {
 
                   expects(locked_int.unsafe() == (ITERATIONS * 2));
               } },
+          { "Locked.SpinLocked.write",
+              [] static noexcept {
+                  static constexpr auto ITERATIONS = 1'000'000;
+                  auto                  locked_int = SpinLocked<Int> { 0 };
+                  const auto            func       = [&locked_int] noexcept {
+                      for (auto foo = 0; foo != ITERATIONS; ++foo) {
+                          auto integer = locked_int.write();
+                          *integer += 1;
+                      }
+                  };
+
+                  auto future_1 = std::async(std::launch::async, func);
+                  auto future_2 = std::async(std::launch::async, func);
+
+                  future_1.wait();
+                  future_2.wait();
+
+                  expects(locked_int.unsafe() == (ITERATIONS * 2));
+              } },
+          { "Locked.SharedLocked.read",
+              [] static noexcept {
+                  static constexpr auto ITERATIONS = 100'000;
+
+                  auto       locked = SharedLocked<std::vector<Int>> { std::vector<Int>(16) };
+                  const auto reader = [&locked] noexcept {
+                      auto consistent = true;
+                      for (auto foo = 0; foo != ITERATIONS; ++foo) {
+                          const auto values = locked.read();
+                          const auto first  = values->front();
+                          consistent        = consistent
+                                       and std::ranges::all_of(*values, [first](auto value) {
+                                               return value == first;
+                                           });
+                      }
+                      return consistent;
+                  };
+                  const auto writer = [&locked] noexcept {
+                      for (auto foo = 0; foo != ITERATIONS; ++foo) {
+                          auto values = locked.write();
+                          for (auto& value : *values) value = foo;
+                      }
+                  };
+
+                  auto future_1 = std::async(std::launch::async, reader);
+                  auto future_2 = std::async(std::launch::async, reader);
+                  auto future_3 = std::async(std::launch::async, writer);
+
+                  expects(future_1.get());
+                  expects(future_2.get());
+                  future_3.wait();
+              } },
+          { "Locked.SeqLocked.copy",
+              [] static noexcept {
+                  static constexpr auto ITERATIONS = 1'000'000;
+                  auto                  locked     = SeqLocked<Pair> {};
+                  const auto            reader     = [&locked] noexcept {
+                      auto consistent = true;
+                      for (auto foo = 0; foo != ITERATIONS; ++foo) {
+                          const auto pair = locked.copy();
+                          consistent      = consistent and pair.b == -pair.a;
+                      }
+                      return consistent;
+                  };
+                  const auto writer = [&locked] noexcept {
+                      for (auto foo = 0; foo != ITERATIONS; ++foo)
+                          locked.assign(Pair { .a = foo, .b = -foo });
+                  };
+
+                  auto future_1 = std::async(std::launch::async, reader);
+                  auto future_2 = std::async(std::launch::async, writer);
+
+                  expects(future_1.get());
+                  future_2.wait();
+                  expects(locked.copy().a == ITERATIONS - 1);
+              } },
           }
     };
 } // namespace
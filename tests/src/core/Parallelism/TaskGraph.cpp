@@ -0,0 +1,101 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    constexpr auto LAYER_COUNT = 8u;
+    constexpr auto LAYER_WIDTH = 16u;
+    constexpr auto NODE_COUNT  = LAYER_COUNT * LAYER_WIDTH;
+
+    /// each node of a layer depends on two nodes of the previous one
+    auto dependenciesOf(UInt32 node) -> std::array<UInt32, 2> {
+        const auto layer = node / LAYER_WIDTH;
+        const auto index = node % LAYER_WIDTH;
+
+        return { (layer - 1) * LAYER_WIDTH + index,
+                 (layer - 1) * LAYER_WIDTH + (index * 7 + 3) % LAYER_WIDTH };
+    }
+
+    auto _ = test::TestSuite {
+        "Core.TaskGraph",
+        {
+          { "TaskGraph.order",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto graph  = TaskGraph {};
+                  auto clock  = std::atomic<UInt32> { 0 };
+                  auto stamps = std::array<std::atomic<UInt32>, NODE_COUNT> {};
+
+                  for (auto node : range(NODE_COUNT))
+                      graph.addTask([&clock, &stamps, node] { stamps[node] = ++clock; });
+                  for (auto node : range(LAYER_WIDTH, NODE_COUNT))
+                      for (auto dependency : dependenciesOf(node))
+                          graph.addDependency(node, dependency);
+
+                  // the graph is reused across runs
+                  for ([[maybe_unused]] auto _ : range(100)) {
+                      clock = 0;
+                      graph.run(pool);
+
+                      expects(clock == NODE_COUNT);
+                      for (auto node : range(LAYER_WIDTH, NODE_COUNT))
+                          for (auto dependency : dependenciesOf(node))
+                              expects(stamps[node] > stamps[dependency]);
+                  }
+              } },
+          { "TaskGraph.noWorker",
+              [] static {
+                  auto pool  = ThreadPool { 0 };
+                  auto graph = TaskGraph {};
+                  auto order = std::vector<TaskGraph::NodeID> {};
+
+                  const auto last  = graph.addTask([&order] { order.emplace_back(0); });
+                  const auto first = graph.addTask([&order] { order.emplace_back(1); });
+                  graph.addDependency(last, first);
+                  graph.run(pool);
+
+                  expects(order == std::vector<TaskGraph::NodeID> { 1, 0 });
+              } },
+          { "TaskGraph.exception",
+              [] static {
+                  auto pool  = ThreadPool { 3 };
+                  auto graph = TaskGraph {};
+                  auto ran   = false;
+
+                  const auto failing = graph.addTask([] { throw std::runtime_error { "" }; });
+                  const auto skipped = graph.addTask([&ran] { ran = true; });
+                  graph.addDependency(skipped, failing);
+
+                  auto thrown = false;
+                  try {
+                      graph.run(pool);
+                  } catch (const std::runtime_error&) { thrown = true; }
+                  expects(thrown);
+                  expects(not ran);
+              } },
+          { "TaskGraph.fromWorker",
+              [] static {
+                  auto pool  = ThreadPool { 2 };
+                  auto graph = TaskGraph {};
+                  auto count = std::atomic<UInt32> { 0 };
+
+                  for ([[maybe_unused]] auto _ : range(NODE_COUNT))
+                      graph.addTask([&count] { ++count; });
+
+                  auto future = pool.postTask<void>([&pool, &graph] { graph.run(pool); });
+                  future.get();
+                  expects(count == NODE_COUNT);
+              } },
+          }
+    };
+} // namespace
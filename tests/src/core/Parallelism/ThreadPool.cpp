@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    constexpr auto ELEMENT_COUNT = 100'003;
+
+    auto makeValues() -> std::vector<Int64> {
+        auto values = std::vector<Int64>(ELEMENT_COUNT);
+        std::ranges::iota(values, 0);
+
+        return values;
+    }
+
+    auto _ = test::TestSuite {
+        "Core.ThreadPool",
+        {
+          { "ThreadPool.future",
+              [] static {
+                  auto pool   = ThreadPool { 2 };
+                  auto future = pool.postTask<Int>([] { return 42; });
+                  expects(future.get() == 42);
+                  expects(not future.valid());
+
+                  auto failing = pool.postTask<void>([] { throw std::runtime_error { "" }; });
+                  auto thrown  = false;
+                  try {
+                      failing.get();
+                  } catch (const std::runtime_error&) { thrown = true; }
+                  expects(thrown);
+              } },
+          { "ThreadPool.future.exception",
+              [] static {
+                  auto pool   = ThreadPool { 2 };
+                  auto future = pool.postTask<Int>([]() -> Int {
+                      throw std::invalid_argument { "task failed" };
+                  });
+
+                  auto moved = std::move(future);
+                  expects(not future.valid());
+                  expects(moved.valid());
+
+                  auto message = std::string {};
+                  try {
+                      [[maybe_unused]] const auto value = moved.get();
+                  } catch (const std::invalid_argument& error) { message = error.what(); }
+                  expects(message == "task failed");
+                  expects(not moved.valid());
+              } },
+          { "ThreadPool.future.brokenPromise",
+              [] static {
+                  auto future = ThreadPool::Future<Int> {};
+                  {
+                      // without workers the task never runs, it is destroyed with the pool
+                      auto pool = ThreadPool { 0 };
+                      future    = pool.postTask<Int>([] { return 42; });
+                  }
+                  expects(future.isReady());
+
+                  auto code = std::error_code {};
+                  try {
+                      [[maybe_unused]] const auto value = future.get();
+                  } catch (const std::future_error& error) { code = error.code(); }
+                  expects(code == std::future_errc::broken_promise);
+              } },
+          { "ThreadPool.parallelFor",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto values = makeValues();
+                  parallelFor(pool, values, [](auto& value) { value *= 2; });
+
+                  auto expected = makeValues();
+                  for (auto& value : expected) value *= 2;
+                  expects(values == expected);
+              } },
+          { "ThreadPool.parallelFor.nested",
+              [] static {
+                  auto pool  = ThreadPool { 3 };
+                  auto outer = std::vector<Int>(64);
+                  auto sum   = std::atomic<Int> { 0 };
+                  parallelFor(
+                      pool,
+                      outer,
+                      [&pool, &sum](auto&) {
+                          auto inner = std::vector<Int>(1'000, 1);
+                          parallelFor(pool, inner, [&sum](auto value) { sum += value; }, 10);
+                      },
+                      1);
+                  expects(sum == 64'000);
+              } },
+          { "ThreadPool.parallelTransform",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto values = makeValues();
+                  auto output = parallelTransform(pool, values, [](auto value) {
+                      return value + 1;
+                  });
+
+                  expects(std::size(output) == std::size(values));
+                  for (auto i : range(std::size(values))) expects(output[i] == values[i] + 1);
+              } },
+          { "ThreadPool.parallelTransformIf",
+              [] static {
+                  auto       pool      = ThreadPool { 3 };
+                  auto       values    = makeValues();
+                  const auto predicate = [](auto value) { return value % 3 == 0; };
+                  const auto func      = [](auto value) { return value / 3; };
+
+                  auto output = parallelTransformIf(pool, values, predicate, func, 777);
+
+                  auto expected = std::vector<Int64> {};
+                  for (auto value : values)
+                      if (predicate(value)) expected.emplace_back(func(value));
+                  expects(output == expected);
+              } },
+          { "ThreadPool.parallelReduce",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto values = makeValues();
+
+                  expects(parallelReduce(pool, values, Int64 { 5 })
+                          == std::ranges::fold_left(values, Int64 { 5 }, std::plus {}));
+              } },
+          { "ThreadPool.parallelScan",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto values = makeValues();
+
+                  auto expected = std::vector<Int64>(std::size(values));
+                  std::inclusive_scan(std::begin(values), std::end(values), std::begin(expected));
+
+                  auto output = std::vector<Int64>(std::size(values));
+                  parallelScan(pool, values, output, std::plus {}, 999);
+                  expects(output == expected);
+
+                  parallelScan(pool, values, values);
+                  expects(values == expected);
+              } },
+          { "ThreadPool.parallelFor.exception",
+              [] static {
+                  auto pool   = ThreadPool { 3 };
+                  auto values = makeValues();
+                  auto thrown = false;
+                  try {
+                      parallelFor(pool, values, [](auto) { throw std::runtime_error { "" }; });
+                  } catch (const std::runtime_error&) { thrown = true; }
+                  expects(thrown);
+              } },
+          }
+    };
+} // namespace
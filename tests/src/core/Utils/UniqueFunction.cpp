@@ -0,0 +1,154 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+
+import Test;
+
+using namespace stormkit::core;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    using Function = UniqueFunction<Int()>;
+
+    /// Returns `value`, the shared pointer is kept alive as long as the callable
+    struct Small {
+        auto operator()() const noexcept -> Int { return value; }
+
+        std::shared_ptr<Int> state;
+        Int                  value;
+    };
+
+    /// Same as Small but too big to be stored inline
+    struct Big {
+        auto operator()() const noexcept -> Int { return value; }
+
+        std::shared_ptr<Int>  state;
+        Int                   value;
+        std::array<Byte, 128> padding = {};
+    };
+
+    /// Small enough but its move constructor may throw, counts its moves
+    struct ThrowingMove {
+        explicit ThrowingMove(Int& counter) noexcept : moves { &counter } {}
+
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&& other) : moves { other.moves } { ++*moves; }
+
+        auto operator()() const noexcept -> Int { return 3; }
+
+        Int* moves;
+    };
+
+    static_assert(Function::fitsInline<Small>());
+    static_assert(not Function::fitsInline<Big>());
+    static_assert(not Function::fitsInline<ThrowingMove>());
+    static_assert(UniqueFunction<Int(), 256>::fitsInline<Big>());
+
+    auto _ = test::TestSuite {
+        "Core.Utils",
+        {
+          { "UniqueFunction.empty",
+              [] static {
+                  auto function = Function {};
+                  expects(not function);
+
+                  function = Function { nullptr };
+                  expects(not function);
+              } },
+          { "UniqueFunction.inline.move",
+              [] static {
+                  auto state    = std::make_shared<Int>(0);
+                  auto function = Function { Small { state, 1 } };
+                  expects(function() == 1);
+                  expects(state.use_count() == 2);
+
+                  auto moved = Function { std::move(function) };
+                  expects(not function);
+                  expects(moved() == 1);
+                  expects(state.use_count() == 2);
+
+                  auto assigned = Function { Small { state, 2 } };
+                  expects(state.use_count() == 3);
+                  assigned = std::move(moved);
+                  expects(not moved);
+                  expects(assigned() == 1);
+                  expects(state.use_count() == 2);
+              } },
+          { "UniqueFunction.heap.move",
+              [] static {
+                  auto state    = std::make_shared<Int>(0);
+                  auto function = Function { Big { state, 1 } };
+                  expects(function() == 1);
+                  expects(state.use_count() == 2);
+
+                  auto moved = Function { std::move(function) };
+                  expects(not function);
+                  expects(moved() == 1);
+                  expects(state.use_count() == 2);
+
+                  auto assigned = Function { Big { state, 2 } };
+                  expects(state.use_count() == 3);
+                  assigned = std::move(moved);
+                  expects(not moved);
+                  expects(assigned() == 1);
+                  expects(state.use_count() == 2);
+              } },
+          { "UniqueFunction.mixed.move",
+              [] static {
+                  auto state = std::make_shared<Int>(0);
+                  auto small = Function { Small { state, 1 } };
+                  auto big   = Function { Big { state, 2 } };
+                  expects(state.use_count() == 3);
+
+                  small = std::move(big);
+                  expects(small() == 2);
+                  expects(state.use_count() == 2);
+
+                  big   = Function { Small { state, 3 } };
+                  small = std::move(big);
+                  expects(small() == 3);
+                  expects(state.use_count() == 2);
+              } },
+          { "UniqueFunction.destroy",
+              [] static {
+                  auto state = std::make_shared<Int>(0);
+                  {
+                      auto small = Function { Small { state, 1 } };
+                      auto big   = Function { Big { state, 2 } };
+                      expects(state.use_count() == 3);
+                  }
+                  expects(state.use_count() == 1);
+
+                  // a moved from function owns nothing anymore
+                  auto moved = Function {};
+                  {
+                      auto big = Function { Big { state, 2 } };
+                      moved    = std::move(big);
+                  }
+                  expects(state.use_count() == 2);
+                  moved = nullptr;
+                  expects(state.use_count() == 1);
+              } },
+          { "UniqueFunction.throwingMove",
+              [] static {
+                  auto moves    = Int { 0 };
+                  auto function = Function { ThrowingMove { moves } };
+                  expects(function() == 3);
+
+                  const auto constructed_moves = moves;
+
+                  // stored on the heap, moving the function only moves the pointer
+                  auto moved = Function { std::move(function) };
+                  auto other = Function {};
+                  other      = std::move(moved);
+                  expects(other() == 3);
+                  expects(moves == constructed_moves);
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,157 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+import stormkit.Engine;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::engine;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    using entities::Entity;
+    using entities::EntityManager;
+    using entities::ExecutionMode;
+
+    using Entities = std::vector<Entity>;
+
+    constexpr auto CELL_SIZE = 10.f;
+
+    auto sorted(Entities entities) -> Entities {
+        std::ranges::sort(entities);
+
+        return entities;
+    }
+
+    /// Entities 1 to 5 spread over several cells, 5 is alone far away
+    auto makeGrid() -> SpatialGrid {
+        auto grid = SpatialGrid { CELL_SIZE };
+        grid.insert(1, { 0.f, 0.f });
+        grid.insert(2, { 5.f, 5.f });
+        grid.insert(3, { 15.f, 0.f });
+        grid.insert(4, { -12.f, 3.f });
+        grid.insert(5, { 100.f, 100.f });
+
+        return grid;
+    }
+
+    auto spawn(EntityManager& world, const math::Vector2F& position) -> Entity {
+        const auto e = world.makeEntity();
+        world.addComponent<PositionComponent>(e, PositionComponent { {}, position });
+
+        return e;
+    }
+
+    auto _ = test::TestSuite {
+        "Engine.ECS",
+        {
+          { "SpatialGrid.query",
+              [] static {
+                  const auto grid = makeGrid();
+                  expects(grid.size() == 5);
+
+                  // the bounds are included
+                  const auto inside = Entities { 1, 2, 3 };
+                  expects(sorted(grid.query({ { 0.f, 0.f }, { 15.f, 5.f } })) == inside);
+
+                  const auto all = Entities { 1, 2, 3, 4, 5 };
+                  expects(sorted(grid.query({ { -50.f, -50.f }, { 150.f, 150.f } })) == all);
+
+                  expects(std::empty(grid.query({ { 30.f, 30.f }, { 90.f, 90.f } })));
+              } },
+          { "SpatialGrid.radius",
+              [] static {
+                  const auto grid = makeGrid();
+
+                  const auto close = Entities { 1, 2 };
+                  expects(sorted(grid.queryRadius({ 0.f, 0.f }, 10.f)) == close);
+
+                  // the radius is included, 3 is exactly at 15
+                  const auto around = Entities { 1, 2, 3, 4 };
+                  expects(sorted(grid.queryRadius({ 0.f, 0.f }, 15.f)) == around);
+
+                  expects(std::empty(grid.queryRadius({ 50.f, 50.f }, 5.f)));
+              } },
+          { "SpatialGrid.nearest",
+              [] static {
+                  const auto grid = makeGrid();
+
+                  const auto first = Entities { 1, 2, 4 };
+                  expects(grid.nearest({ 0.f, 0.f }, 3) == first);
+
+                  // every entity, even when the rings have to reach the far one
+                  const auto all = Entities { 5, 3, 2, 1, 4 };
+                  expects(grid.nearest({ 100.f, 100.f }, 10) == all);
+
+                  const auto bounded = Entities { 1, 2 };
+                  expects(grid.nearest({ 0.f, 0.f }, 10, 10.f) == bounded);
+
+                  expects(std::empty(grid.nearest({ 0.f, 0.f }, 0)));
+                  expects(std::empty(SpatialGrid { CELL_SIZE }.nearest({ 0.f, 0.f }, 3)));
+              } },
+          { "SpatialGrid.move",
+              [] static {
+                  auto grid = makeGrid();
+
+                  // same cell then another cell, the entity is never duplicated
+                  grid.insert(1, { 1.f, 1.f });
+                  grid.insert(1, { 55.f, 55.f });
+                  expects(grid.size() == 5);
+                  expects(grid.nearest({ 55.f, 55.f }, 1) == Entities { 1 });
+
+                  const auto left = Entities { 2 };
+                  expects(grid.query({ { 0.f, 0.f }, { 9.f, 9.f } }) == left);
+
+                  // removing it again does nothing
+                  grid.remove(2);
+                  grid.remove(2);
+                  expects(not grid.contains(2));
+                  expects(grid.size() == 4);
+                  expects(grid.query({ { 50.f, 50.f }, { 60.f, 60.f } }) == Entities { 1 });
+
+                  grid.clear();
+                  expects(grid.size() == 0);
+                  expects(std::empty(grid.queryRadius({ 0.f, 0.f }, 1000.f)));
+              } },
+          { "SpatialIndexSystem.sync",
+              [] static {
+                  auto        world  = EntityManager { ExecutionMode::Deterministic };
+                  const auto& system = world.addSystem<SpatialIndexSystem>(CELL_SIZE);
+                  const auto& grid   = system.grid();
+
+                  const auto a = spawn(world, { 0.f, 0.f });
+                  const auto b = spawn(world, { 20.f, 0.f });
+                  world.step(Secondf { 0 });
+                  expects(grid.size() == 2);
+                  expects(grid.queryRadius({ 0.f, 0.f }, 1.f) == Entities { a });
+
+                  world.getComponent<PositionComponent>(a).position = { 40.f, 0.f };
+                  world.step(Secondf { 0 });
+                  expects(std::empty(grid.queryRadius({ 0.f, 0.f }, 1.f)));
+                  expects(grid.queryRadius({ 40.f, 0.f }, 1.f) == Entities { a });
+
+                  world.destroyComponent<PositionComponent>(a);
+                  world.step(Secondf { 0 });
+                  expects(not grid.contains(a));
+                  expects(grid.size() == 1);
+
+                  // removed then added again in the same frame, it stays in the grid
+                  world.destroyComponent<PositionComponent>(b);
+                  world.addComponent<PositionComponent>(b, PositionComponent { {}, { 5.f, 5.f } });
+                  world.step(Secondf { 0 });
+                  expects(grid.queryRadius({ 5.f, 5.f }, 1.f) == Entities { b });
+
+                  world.destroyEntity(b);
+                  world.step(Secondf { 0 });
+                  expects(grid.size() == 0);
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+import stormkit.Engine;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::engine;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    using entities::Entity;
+    using entities::EntityManager;
+    using entities::ExecutionMode;
+
+    auto spawn(EntityManager&        world,
+               const math::Vector3F& position,
+               Entity                parent = entities::INVALID_ENTITY) -> Entity {
+        const auto e = world.makeEntity();
+        world.addComponent<TransformComponent>(e, TransformComponent { {}, position });
+        if (parent != entities::INVALID_ENTITY)
+            world.addComponent<HierarchyComponent>(e, HierarchyComponent { {}, parent });
+
+        return e;
+    }
+
+    /// true if the world matrix of `e` translates the origin to `position`
+    auto isAt(const EntityManager& world, Entity e, const math::Vector3F& position) -> bool {
+        const auto& transform = world.getComponent<TransformComponent>(e);
+
+        return math::Vector3F { transform.world[3] } == position;
+    }
+
+    auto _ = test::TestSuite {
+        "Engine.ECS",
+        {
+          { "TransformSystem.propagate",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+                  world.addSystem<TransformSystem>();
+
+                  const auto root  = spawn(world, { 1.f, 0.f, 0.f });
+                  const auto child = spawn(world, { 0.f, 2.f, 0.f }, root);
+                  const auto leaf  = spawn(world, { 0.f, 0.f, 3.f }, child);
+                  world.step(Secondf { 0 });
+
+                  expects(isAt(world, root, { 1.f, 0.f, 0.f }));
+                  expects(isAt(world, child, { 1.f, 2.f, 0.f }));
+                  expects(isAt(world, leaf, { 1.f, 2.f, 3.f }));
+
+                  // a local change is propagated to the whole subtree
+                  world.getComponent<TransformComponent>(root).position = { 5.f, 0.f, 0.f };
+                  world.step(Secondf { 0 });
+
+                  expects(isAt(world, child, { 5.f, 2.f, 0.f }));
+                  expects(isAt(world, leaf, { 5.f, 2.f, 3.f }));
+
+                  world.getComponent<TransformComponent>(leaf).position = { 0.f, 0.f, 4.f };
+                  world.step(Secondf { 0 });
+
+                  expects(isAt(world, child, { 5.f, 2.f, 0.f }));
+                  expects(isAt(world, leaf, { 5.f, 2.f, 4.f }));
+              } },
+          { "TransformSystem.reparent",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+                  world.addSystem<TransformSystem>();
+
+                  const auto first = spawn(world, { 1.f, 0.f, 0.f });
+                  const auto other = spawn(world, { 0.f, 10.f, 0.f });
+                  const auto child = spawn(world, { 0.f, 0.f, 3.f }, first);
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, child, { 1.f, 0.f, 3.f }));
+
+                  world.getComponent<HierarchyComponent>(child).parent = other;
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, child, { 0.f, 10.f, 3.f }));
+
+                  // the new parent moves its new child only
+                  world.getComponent<TransformComponent>(first).position = { 2.f, 0.f, 0.f };
+                  world.getComponent<TransformComponent>(other).position = { 0.f, 20.f, 0.f };
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, child, { 0.f, 20.f, 3.f }));
+              } },
+          { "TransformSystem.removeParent",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+                  world.addSystem<TransformSystem>();
+
+                  const auto parent = spawn(world, { 1.f, 0.f, 0.f });
+                  const auto child  = spawn(world, { 0.f, 0.f, 3.f }, parent);
+                  const auto leaf   = spawn(world, { 0.f, 2.f, 0.f }, child);
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, leaf, { 1.f, 2.f, 3.f }));
+
+                  // the orphan becomes a root, its own subtree follows it
+                  world.destroyEntity(parent);
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, child, { 0.f, 0.f, 3.f }));
+                  expects(isAt(world, leaf, { 0.f, 2.f, 3.f }));
+
+                  world.destroyComponent<HierarchyComponent>(leaf);
+                  world.step(Secondf { 0 });
+                  expects(isAt(world, leaf, { 0.f, 2.f, 0.f }));
+              } },
+          { "TransformSystem.parallel",
+              [] static {
+                  // enough roots to be split in several batches
+                  constexpr auto ROOT_COUNT = 10'000u;
+
+                  auto world = EntityManager { ExecutionMode::Parallel };
+                  world.addSystem<TransformSystem>();
+
+                  auto children = std::vector<Entity> {};
+                  children.reserve(ROOT_COUNT);
+                  for (auto i : range(ROOT_COUNT)) {
+                      const auto root = spawn(world, { as<float>(i), 0.f, 0.f });
+                      children.emplace_back(spawn(world, { 0.f, 1.f, 0.f }, root));
+                  }
+                  world.step(Secondf { 0 });
+
+                  auto placed = true;
+                  for (auto i : range(ROOT_COUNT))
+                      placed = placed and isAt(world, children[i], { as<float>(i), 1.f, 0.f });
+                  expects(placed);
+              } },
+          }
+    };
+} // namespace
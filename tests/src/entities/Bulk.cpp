@@ -0,0 +1,200 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct AComponent: Component {
+        static constexpr Type TYPE = "AComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    struct BComponent: Component {
+        static constexpr Type TYPE = "BComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    /// Counts the entities it owns and the entities reported as removed
+    class CountingSystem final: public System {
+      public:
+        explicit CountingSystem(EntityManager& manager)
+            : System { manager, 0, { AComponent::TYPE } } {}
+
+        auto update(Secondf) -> void override {}
+
+        [[nodiscard]] auto size() const noexcept -> RangeExtent { return std::size(m_entities); }
+
+        RangeExtent removed = 0;
+
+      private:
+        auto onMessageReceived(const Message& message) -> void override {
+            if (message.id == EntityManager::REMOVED_ENTITY_MESSAGE_ID)
+                removed += std::size(message.entities);
+        }
+    };
+
+    constexpr auto ENTITY_COUNT = RangeExtent { 1000 };
+
+    auto _ = test::TestSuite {
+        "Entities.Bulk",
+        {
+          { "Bulk.makeEntities.copies",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& system = world.addSystem<CountingSystem>();
+                  world.reserveEntities(ENTITY_COUNT);
+
+                  const auto entities = world.makeEntities(ENTITY_COUNT,
+                                                           AComponent { {}, 5 },
+                                                           BComponent { {}, 7 });
+                  expects(std::size(entities) == ENTITY_COUNT);
+                  expects(std::ranges::all_of(entities, [&world](auto e) {
+                      return world.hasEntity(e);
+                  }));
+
+                  // the entities are committed at the next step
+                  expects(world.entityCount() == 0);
+                  world.step(Secondf { 0 });
+                  expects(world.entityCount() == ENTITY_COUNT);
+                  expects(system.size() == ENTITY_COUNT);
+
+                  const auto& const_world = std::as_const(world);
+                  expects(std::ranges::all_of(entities, [&const_world](auto e) {
+                      return const_world.getComponent<AComponent>(e).value == 5
+                             and const_world.getComponent<BComponent>(e).value == 7;
+                  }));
+              } },
+          { "Bulk.makeEntities.spans",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  auto a_components = std::vector<AComponent> {};
+                  auto b_components = std::vector<BComponent> {};
+                  for (auto i : range(as<UInt32>(ENTITY_COUNT))) {
+                      a_components.emplace_back(AComponent { {}, i });
+                      b_components.emplace_back(BComponent { {}, i * 2 });
+                  }
+
+                  const auto entities
+                      = world.makeEntities(std::span<const AComponent> { a_components },
+                                           std::span<const BComponent> { b_components });
+                  world.step(Secondf { 0 });
+
+                  auto matching = true;
+                  for (auto i : range(ENTITY_COUNT)) {
+                      const auto& a = std::as_const(world).getComponent<AComponent>(entities[i]);
+                      const auto& b = std::as_const(world).getComponent<BComponent>(entities[i]);
+                      matching      = matching and a.value == i and b.value == i * 2;
+                  }
+                  expects(matching);
+              } },
+          { "Bulk.recycle",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  constexpr auto HALF = ENTITY_COUNT / 2;
+
+                  const auto first = world.makeEntities(ENTITY_COUNT, AComponent {});
+                  world.step(Secondf { 0 });
+                  const auto destroyed = std::span { first }.first(HALF);
+                  world.destroyEntities(destroyed);
+                  world.step(Secondf { 0 });
+
+                  const auto second = world.makeEntities(ENTITY_COUNT, AComponent {});
+                  world.step(Secondf { 0 });
+                  expects(world.entityCount() == ENTITY_COUNT + HALF);
+                  expects(std::ranges::none_of(destroyed, [&world](auto e) {
+                      return world.hasEntity(e);
+                  }));
+
+                  // the freed indices are reused first, with a new generation
+                  auto freed = destroyed
+                               | std::views::transform(entityIndex)
+                               | std::ranges::to<std::vector>();
+                  auto recycled = second
+                                  | std::views::filter([](auto e) static {
+                                        return entityGeneration(e) == 1;
+                                    })
+                                  | std::views::transform(entityIndex)
+                                  | std::ranges::to<std::vector>();
+                  std::ranges::sort(freed);
+                  std::ranges::sort(recycled);
+                  expects(freed == recycled);
+
+                  auto handles = second;
+                  handles.insert(std::ranges::end(handles),
+                                 std::ranges::begin(first) + HALF,
+                                 std::ranges::end(first));
+                  std::ranges::sort(handles);
+                  expects(std::ranges::adjacent_find(handles) == std::ranges::end(handles));
+              } },
+          { "Bulk.destroyEntities",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& system = world.addSystem<CountingSystem>();
+
+                  const auto entities = world.makeEntities(4, AComponent {});
+                  world.step(Secondf { 0 });
+                  world.destroyEntity(entities[0]);
+                  world.step(Secondf { 0 });
+                  expects(system.removed == 1);
+
+                  // dead, invalid, already destroyed and repeated entities are reported once
+                  system.removed = 0;
+                  world.destroyEntity(entities[1]);
+                  const auto targets = std::array {
+                      entities[0], INVALID_ENTITY, entities[1], entities[2], entities[2]
+                  };
+                  world.destroyEntities(targets);
+                  world.destroyEntity(entities[2]);
+                  world.step(Secondf { 0 });
+
+                  expects(system.removed == 2);
+                  expects(system.size() == 1);
+                  expects(world.entityCount() == 1);
+                  expects(world.hasEntity(entities[3]));
+                  expects(world.componentPool<AComponent>().size() == 1);
+              } },
+          { "Bulk.destroyAllEntities",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& system = world.addSystem<CountingSystem>();
+
+                  const auto entities = world.makeEntities(ENTITY_COUNT, AComponent {});
+                  world.step(Secondf { 0 });
+
+                  world.destroyAllEntities();
+                  world.step(Secondf { 0 });
+                  expects(system.removed == ENTITY_COUNT);
+                  expects(system.size() == 0);
+                  expects(world.entityCount() == 0);
+                  expects(world.componentPool<AComponent>().size() == 0);
+                  expects(std::ranges::none_of(entities, [&world](auto e) {
+                      return world.hasEntity(e);
+                  }));
+
+                  // respawning works as from a fresh EntityManager
+                  const auto respawned = world.makeEntities(ENTITY_COUNT, AComponent { {}, 3 });
+                  world.step(Secondf { 0 });
+                  expects(world.entityCount() == ENTITY_COUNT);
+                  expects(system.size() == ENTITY_COUNT);
+                  expects(std::as_const(world).getComponent<AComponent>(respawned.back()).value
+                          == 3);
+              } },
+          }
+    };
+} // namespace
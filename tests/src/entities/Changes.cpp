@@ -0,0 +1,169 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct ValueComponent: Component {
+        static constexpr Type TYPE = "ValueComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    /// Counts the changes and removals reported to each of its updates
+    template<UInt32 PRIORITY>
+    class Reader final: public System {
+      public:
+        explicit Reader(EntityManager& manager)
+            : System { manager, PRIORITY, { ValueComponent::TYPE }, {} } {}
+
+        auto update(Secondf) -> void override {
+            changes = 0;
+            m_manager->changed<ValueComponent>(lastRunTick()).each([this](auto, auto&) {
+                changes += 1;
+            });
+            removals = std::size(m_manager->removed<ValueComponent>(lastRunTick()));
+        }
+
+        RangeExtent changes  = 0;
+        RangeExtent removals = 0;
+
+      private:
+        auto onMessageReceived(const Message&) -> void override {}
+    };
+
+    /// Writes the value of `target` during its next update
+    template<UInt32 PRIORITY>
+    class Writer final: public System {
+      public:
+        explicit Writer(EntityManager& manager)
+            : System { manager, PRIORITY, {}, { ValueComponent::TYPE } },
+              m_world { borrowMut(manager) } {}
+
+        auto update(Secondf) -> void override {
+            if (target == INVALID_ENTITY) return;
+
+            m_world->getComponent<ValueComponent>(target).value += 1;
+            target = INVALID_ENTITY;
+        }
+
+        Entity target = INVALID_ENTITY;
+
+      private:
+        auto onMessageReceived(const Message&) -> void override {}
+
+        Ref<EntityManager> m_world;
+    };
+
+    auto spawn(EntityManager& world) -> Entity {
+        const auto e = world.makeEntity();
+        world.addComponent<ValueComponent>(e);
+
+        return e;
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Changes",
+        {
+          { "Changes.outside",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& reader = world.addSystem<Reader<0>>();
+
+                  const auto e = spawn(world);
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 1);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+
+                  world.getComponent<ValueComponent>(e).value = 2;
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 1);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+              } },
+          { "Changes.since",
+              [] static {
+                  auto       world = EntityManager { ExecutionMode::Deterministic };
+                  const auto e     = spawn(world);
+                  world.step(Secondf { 0 });
+
+                  const auto since = world.tick();
+                  expects(std::ranges::distance(world.changed<const ValueComponent>(since)) == 0);
+
+                  world.getComponent<ValueComponent>(e).value = 2;
+                  expects(std::ranges::distance(world.changed<const ValueComponent>(since)) == 1);
+              } },
+          { "Changes.writerBefore",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& writer = world.addSystem<Writer<0>>();
+                  auto& reader = world.addSystem<Reader<1>>();
+
+                  const auto e = spawn(world);
+                  world.step(Secondf { 0 });
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+
+                  // written earlier in the same frame
+                  writer.target = e;
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 1);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+              } },
+          { "Changes.writerAfter",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& reader = world.addSystem<Reader<0>>();
+                  auto& writer = world.addSystem<Writer<1>>();
+
+                  const auto e = spawn(world);
+                  world.step(Secondf { 0 });
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+
+                  // written after the reader, it is seen the next frame
+                  writer.target = e;
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 1);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.changes == 0);
+              } },
+          { "Changes.removed",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& reader = world.addSystem<Reader<0>>();
+
+                  const auto e = spawn(world);
+                  world.step(Secondf { 0 });
+
+                  world.destroyComponent<ValueComponent>(e);
+                  world.step(Secondf { 0 });
+                  expects(reader.removals == 1);
+
+                  world.step(Secondf { 0 });
+                  expects(reader.removals == 0);
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,143 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct ValueComponent: Component {
+        static constexpr Type TYPE = "ValueComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    auto spawn(EntityManager& world, UInt32 value) -> Entity {
+        const auto e = world.makeEntity();
+        world.addComponent<ValueComponent>(e, ValueComponent { {}, value });
+        world.step(Secondf { 0 });
+
+        return e;
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.CommandBuffer",
+        {
+          { "CommandBuffer.replace",
+              [] static {
+                  auto       world = EntityManager { ExecutionMode::Deterministic };
+                  const auto e     = spawn(world, 1);
+
+                  world.commands().destroyComponent<ValueComponent>(e);
+                  world.commands().addComponent<ValueComponent>(e, ValueComponent { {}, 2 });
+                  world.step(Secondf { 0 });
+
+                  expects(world.hasComponent<ValueComponent>(e));
+                  expects(world.getComponent<ValueComponent>(e).value == 2);
+              } },
+          { "CommandBuffer.addThenDestroy",
+              [] static {
+                  auto       world = EntityManager { ExecutionMode::Deterministic };
+                  const auto e     = world.makeEntity();
+                  world.step(Secondf { 0 });
+
+                  world.commands().addComponent<ValueComponent>(e);
+                  world.commands().destroyComponent<ValueComponent>(e);
+                  world.step(Secondf { 0 });
+
+                  expects(not world.hasComponent<ValueComponent>(e));
+              } },
+          { "CommandBuffer.makeEntity",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  const auto e = world.commands().makeEntity();
+                  world.commands().addComponent<ValueComponent>(e, ValueComponent { {}, 3 });
+                  world.step(Secondf { 0 });
+
+                  expects(world.hasEntity(e));
+                  expects(world.getComponent<ValueComponent>(e).value == 3);
+
+                  world.commands().destroyEntity(e);
+                  world.step(Secondf { 0 });
+                  expects(not world.hasEntity(e));
+              } },
+          { "CommandBuffer.makeEntity.populated",
+              [] static {
+                  auto       world    = EntityManager { ExecutionMode::Deterministic };
+                  const auto first    = spawn(world, 1);
+                  const auto recycled = spawn(world, 2);
+                  world.destroyEntity(recycled);
+                  world.step(Secondf { 0 });
+
+                  // the reserved indices are shared with the EntityManager, a recycled slot
+                  // is never handed out twice
+                  const auto reserved = world.commands().makeEntity();
+                  const auto made     = world.makeEntity();
+                  expects(reserved != made);
+                  expects(reserved != first);
+
+                  // a standalone buffer can target the reserved entity once played back
+                  auto buffer = CommandBuffer {};
+                  buffer.addComponent<ValueComponent>(reserved, ValueComponent { {}, 6 });
+                  world.step(Secondf { 0 });
+                  buffer.playback(world);
+
+                  expects(world.hasEntity(first));
+                  expects(world.hasEntity(reserved));
+                  expects(world.hasEntity(made));
+                  expects(world.entityCount() == 3);
+                  expects(world.getComponent<ValueComponent>(reserved).value == 6);
+              } },
+          { "CommandBuffer.interleaved",
+              [] static {
+                  auto       world  = EntityManager { ExecutionMode::Deterministic };
+                  const auto e      = spawn(world, 1);
+                  auto       buffer = CommandBuffer {};
+
+                  // the thread switches between the two buffers, each keeps its own commands
+                  world.commands().destroyComponent<ValueComponent>(e);
+                  buffer.addComponent<ValueComponent>(e, ValueComponent { {}, 4 });
+                  world.commands().addComponent<ValueComponent>(e, ValueComponent { {}, 5 });
+
+                  world.step(Secondf { 0 });
+                  expects(world.getComponent<ValueComponent>(e).value == 5);
+                  expects(not buffer.empty());
+
+                  world.commands().destroyComponent<ValueComponent>(e);
+                  world.step(Secondf { 0 });
+                  buffer.playback(world);
+                  expects(world.getComponent<ValueComponent>(e).value == 4);
+              } },
+          { "CommandBuffer.threads",
+              [] static {
+                  auto world    = EntityManager { ExecutionMode::Deterministic };
+                  auto entities = std::vector<Entity> {};
+                  for (auto i : range(8u)) entities.emplace_back(spawn(world, i));
+
+                  {
+                      auto threads = std::vector<std::jthread> {};
+                      for (auto entity : entities)
+                          threads.emplace_back([&world, entity] {
+                              world.commands().destroyComponent<ValueComponent>(entity);
+                          });
+                  }
+                  world.step(Secondf { 0 });
+
+                  expects(std::ranges::none_of(entities, [&world](auto entity) {
+                      return world.hasComponent<ValueComponent>(entity);
+                  }));
+              } },
+          }
+    };
+} // namespace
@@ -0,0 +1,136 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct ValueComponent: Component {
+        static constexpr Type TYPE = "ValueComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    using MessageIds = std::initializer_list<UInt32>;
+    using Batches    = std::vector<std::pair<UInt32, std::vector<Entity>>>;
+
+    /// Counts the messages and the entities reported by each message id
+    template<UInt32 PRIORITY>
+    class CountingSystem final: public System {
+      public:
+        explicit CountingSystem(EntityManager& manager)
+            : System { manager, PRIORITY, { ValueComponent::TYPE } } {}
+
+        CountingSystem(MessageIds message_ids, EntityManager& manager)
+            : CountingSystem { manager } {
+            subscribe(message_ids);
+        }
+
+        auto update(Secondf) -> void override {}
+
+        HashMap<UInt32, RangeExtent> counts;
+        HashMap<UInt32, RangeExtent> batches;
+
+      private:
+        auto onMessageReceived(const Message& message) -> void override {
+            counts[message.id]  += std::size(message.entities);
+            batches[message.id] += 1;
+        }
+    };
+
+    constexpr auto ADDED   = EntityManager::ADDED_ENTITY_MESSAGE_ID;
+    constexpr auto REMOVED = EntityManager::REMOVED_ENTITY_MESSAGE_ID;
+
+    /// Returns the messages delivered by `bus` as (id, entities) pairs
+    auto delivered(const MessageBus& bus) -> Batches {
+        auto output = Batches {};
+        bus.forEach([&output](const Message& message) {
+            output.emplace_back(message.id, message.entities | std::ranges::to<std::vector>());
+        });
+
+        return output;
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Messages",
+        {
+          { "Messages.destroyAll",
+              [] static {
+                  auto  world  = EntityManager { ExecutionMode::Deterministic };
+                  auto& system = world.addSystem<CountingSystem<0>>();
+
+                  const auto alive = world.makeEntity();
+                  world.step(Secondf { 0 });
+                  const auto pending = world.makeEntity();
+                  system.counts.clear();
+
+                  // already reported once, neither is reported again
+                  world.destroyEntity(alive);
+                  world.destroyEntity(pending);
+                  world.destroyAllEntities();
+                  world.step(Secondf { 0 });
+
+                  expects(system.counts[REMOVED] == 2);
+                  expects(world.entityCount() == 0);
+              } },
+          { "Messages.coalesce",
+              [] static {
+                  auto       bus      = MessageBus {};
+                  const auto entities = std::array<Entity, 2> { 3, 4 };
+                  bus.push(1, 1);
+                  bus.push(2, 2);
+                  bus.push(1, entities);
+                  bus.push(3, std::span<const Entity> {});
+
+                  // one batch per id, in the order of their first push
+                  const auto expected = Batches { { 1, { 1, 3, 4 } }, { 2, { 2 } } };
+                  expects(delivered(bus) == expected);
+
+                  bus.clear();
+                  expects(bus.empty());
+                  expects(std::empty(delivered(bus)));
+
+                  // the buffers are reused, the order only depends on the new pushes
+                  bus.push(2, 5);
+                  bus.push(1, 6);
+                  const auto reused = Batches { { 2, { 5 } }, { 1, { 6 } } };
+                  expects(delivered(bus) == reused);
+              } },
+          { "Messages.subscribe",
+              [] static {
+                  auto  world    = EntityManager { ExecutionMode::Deterministic };
+                  auto& all      = world.addSystem<CountingSystem<0>>();
+                  auto& removals = world.addSystem<CountingSystem<1>>(MessageIds { REMOVED });
+                  auto& deaf     = world.addSystem<CountingSystem<2>>(MessageIds {});
+
+                  const auto entities = world.makeEntities(3, ValueComponent {});
+                  world.makeEntity();
+                  world.step(Secondf { 0 });
+
+                  // the creations of a frame are delivered as one batch
+                  expects(all.counts[ADDED] == 4);
+                  expects(all.batches[ADDED] == 1);
+                  expects(not removals.counts.contains(ADDED));
+
+                  world.destroyEntities(entities);
+                  world.step(Secondf { 0 });
+
+                  expects(all.counts[REMOVED] == 3);
+                  expects(removals.counts[REMOVED] == 3);
+                  expects(removals.batches[REMOVED] == 1);
+                  expects(std::empty(deaf.counts));
+              } },
+          }
+    };
+} // namespace
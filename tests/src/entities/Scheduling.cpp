@@ -0,0 +1,196 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct AComponent: Component {
+        static constexpr Type TYPE = "AComponent"_component_type;
+    };
+
+    struct BComponent: Component {
+        static constexpr Type TYPE = "BComponent"_component_type;
+    };
+
+    /// Start and end of each system update, identified by the system priority
+    class Log {
+      public:
+        auto begin(UInt32 system) -> void {
+            auto lock = std::scoped_lock { m_mutex };
+            m_events.emplace_back(system, false);
+            m_threads[system] = std::this_thread::get_id();
+        }
+
+        auto end(UInt32 system) -> void {
+            auto lock = std::scoped_lock { m_mutex };
+            m_events.emplace_back(system, true);
+        }
+
+        /// true if `first` ended before `second` started, in every step
+        [[nodiscard]] auto before(UInt32 first, UInt32 second) const -> bool {
+            auto first_ends    = 0u;
+            auto second_starts = 0u;
+            for (auto [system, ended] : m_events) {
+                if (system == first and ended) ++first_ends;
+                else if (system == second and not ended and ++second_starts > first_ends)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /// Systems in the order they started
+        [[nodiscard]] auto starts() const -> std::vector<UInt32> {
+            return m_events
+                   | std::views::filter([](const auto& event) static { return not event.second; })
+                   | std::views::keys
+                   | std::ranges::to<std::vector>();
+        }
+
+        [[nodiscard]] auto thread(UInt32 system) const -> std::thread::id {
+            return m_threads.at(system);
+        }
+
+      private:
+        mutable std::mutex                   m_mutex;
+        std::vector<std::pair<UInt32, bool>> m_events;
+        HashMap<UInt32, std::thread::id>     m_threads;
+    };
+
+    /// Logs its updates, which last long enough for a wrong schedule to overlap them
+    template<UInt32 PRIORITY>
+    class LoggingSystem: public System {
+      public:
+        auto update(Secondf) -> void override {
+            m_log->begin(PRIORITY);
+            std::this_thread::sleep_for(std::chrono::milliseconds { 2 });
+            m_log->end(PRIORITY);
+        }
+
+      protected:
+        LoggingSystem(Log& log, EntityManager& manager, ComponentTypes reads, ComponentTypes writes)
+            : System { manager, PRIORITY, std::move(reads), std::move(writes) },
+              m_log { borrowMut(log) } {}
+
+        LoggingSystem(Log& log, EntityManager& manager)
+            : System { manager, PRIORITY, {} }, m_log { borrowMut(log) } {}
+
+      private:
+        auto onMessageReceived(const Message&) -> void override {}
+
+        Ref<Log> m_log;
+    };
+
+    template<UInt32 PRIORITY, class T>
+    class Reader final: public LoggingSystem<PRIORITY> {
+      public:
+        Reader(Log& log, EntityManager& manager)
+            : LoggingSystem<PRIORITY> { log, manager, { T::TYPE }, {} } {}
+    };
+
+    template<UInt32 PRIORITY, class T>
+    class Writer final: public LoggingSystem<PRIORITY> {
+      public:
+        Writer(Log& log, EntityManager& manager)
+            : LoggingSystem<PRIORITY> { log, manager, {}, { T::TYPE } } {}
+    };
+
+    /// Declares no access, it conflicts with every other system
+    template<UInt32 PRIORITY>
+    class Exclusive final: public LoggingSystem<PRIORITY> {
+      public:
+        Exclusive(Log& log, EntityManager& manager) : LoggingSystem<PRIORITY> { log, manager } {}
+    };
+
+    auto step(EntityManager& world) -> void {
+        for ([[maybe_unused]] auto _ : range(4)) world.step(Secondf { 0 });
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Scheduling",
+        {
+          { "Scheduling.conflicts",
+              [] static {
+                  auto        log    = Log {};
+                  auto        world  = EntityManager { ExecutionMode::Parallel };
+                  const auto& writer = world.addSystem<Writer<0, AComponent>>(log);
+                  const auto& reader = world.addSystem<Reader<1, AComponent>>(log);
+                  const auto& other  = world.addSystem<Reader<2, BComponent>>(log);
+
+                  expects(writer.conflictsWith(reader));
+                  expects(reader.conflictsWith(writer));
+                  expects(not writer.conflictsWith(other));
+                  expects(not reader.conflictsWith(other));
+
+                  step(world);
+
+                  // the reader waits for the writer of lower priority
+                  expects(log.before(0, 1));
+              } },
+          { "Scheduling.writers",
+              [] static {
+                  auto log   = Log {};
+                  auto world = EntityManager { ExecutionMode::Parallel };
+                  world.addSystem<Writer<2, AComponent>>(log);
+                  world.addSystem<Writer<0, AComponent>>(log);
+                  world.addSystem<Writer<1, AComponent>>(log);
+                  world.addSystem<Reader<3, BComponent>>(log);
+
+                  step(world);
+
+                  // conflicting systems keep the priority order
+                  expects(log.before(0, 1));
+                  expects(log.before(1, 2));
+              } },
+          { "Scheduling.exclusive",
+              [] static {
+                  auto log   = Log {};
+                  auto world = EntityManager { ExecutionMode::Parallel };
+                  world.addSystem<Reader<0, AComponent>>(log);
+                  world.addSystem<Reader<1, BComponent>>(log);
+                  world.addSystem<Exclusive<2>>(log);
+                  world.addSystem<Reader<3, AComponent>>(log);
+                  world.addSystem<Reader<4, BComponent>>(log);
+
+                  step(world);
+
+                  expects(log.thread(2) == std::this_thread::get_id());
+                  expects(log.before(0, 2));
+                  expects(log.before(1, 2));
+                  expects(log.before(2, 3));
+                  expects(log.before(2, 4));
+              } },
+          { "Scheduling.deterministic",
+              [] static {
+                  auto log   = Log {};
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+                  world.addSystem<Reader<2, BComponent>>(log);
+                  world.addSystem<Reader<0, AComponent>>(log);
+                  world.addSystem<Reader<1, BComponent>>(log);
+
+                  world.step(Secondf { 0 });
+
+                  // nothing overlaps, even the systems which could run concurrently
+                  const auto expected = std::vector<UInt32> { 0, 1, 2 };
+                  expects(log.starts() == expected);
+                  expects(log.before(0, 1));
+                  expects(log.before(1, 2));
+                  expects(log.thread(0) == std::this_thread::get_id());
+                  expects(log.thread(1) == std::this_thread::get_id());
+                  expects(log.thread(2) == std::this_thread::get_id());
+              } },
+          }
+    };
+} // namespace
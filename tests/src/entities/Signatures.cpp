@@ -0,0 +1,160 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    /// Distinct component types, enough of them to use more than the inline signature bits
+    template<UInt32 N>
+    struct NumberedComponent: Component {
+        static constexpr Type TYPE = "NumberedComponent"_component_type + N;
+    };
+
+    using AComponent = NumberedComponent<0>;
+    using BComponent = NumberedComponent<1>;
+
+    constexpr auto TYPE_COUNT = UInt32 { ComponentSignature::WORD_BITS + 8 };
+
+    /// Receives the entities owning every component of `Ts`
+    template<UInt32 PRIORITY, class... Ts>
+    class MatchingSystem final: public System {
+      public:
+        explicit MatchingSystem(EntityManager& manager)
+            : System { manager, PRIORITY, { Ts::TYPE... } } {}
+
+        auto update(Secondf) -> void override {}
+
+        [[nodiscard]] auto matches(Entity e) const -> bool { return m_entities.contains(e); }
+
+      private:
+        auto onMessageReceived(const Message&) -> void override {}
+    };
+
+    using ABSystem = MatchingSystem<0, AComponent, BComponent>;
+
+    template<UInt32... Ns>
+    auto addNumbered(EntityManager& world, Entity e, std::integer_sequence<UInt32, Ns...>)
+        -> void {
+        (world.addComponent<NumberedComponent<Ns>>(e), ...);
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Signatures",
+        {
+          { "ComponentSignature.bits",
+              [] static {
+                  auto signature = ComponentSignature {};
+                  expects(signature.none());
+
+                  signature.set(3);
+                  signature.set(63);
+                  signature.set(64);
+                  signature.set(200);
+                  expects(signature.test(3));
+                  expects(signature.test(63));
+                  expects(signature.test(64));
+                  expects(signature.test(200));
+                  expects(not signature.test(4));
+                  expects(not signature.test(1000));
+
+                  auto ids = std::vector<ComponentId> {};
+                  signature.forEach([&ids](ComponentId id) { ids.emplace_back(id); });
+                  const auto expected = std::vector<ComponentId> { 3, 63, 64, 200 };
+                  expects(ids == expected);
+
+                  signature.reset(200);
+                  signature.reset(500);
+                  expects(not signature.test(200));
+
+                  signature.clear();
+                  expects(signature.none());
+              } },
+          { "ComponentSignature.compare",
+              [] static {
+                  auto small = ComponentSignature {};
+                  auto big   = ComponentSignature {};
+                  small.set(1);
+                  big.set(1);
+
+                  // the unused overflow words don't matter
+                  big.set(130);
+                  big.reset(130);
+                  expects(small == big);
+                  expects(big == small);
+
+                  auto mask = ComponentSignature {};
+                  mask.set(1);
+                  mask.set(130);
+                  expects(not big.contains(mask));
+                  expects(mask.contains(big));
+
+                  big.set(130);
+                  expects(big.contains(mask));
+                  expects(big.contains(ComponentSignature {}));
+                  expects(small != big);
+              } },
+          { "Signatures.membership",
+              [] static {
+                  auto        world  = EntityManager { ExecutionMode::Deterministic };
+                  const auto& system = world.addSystem<ABSystem>();
+
+                  const auto e = world.makeEntity();
+                  world.addComponent<AComponent>(e);
+                  world.step(Secondf { 0 });
+                  expects(not system.matches(e));
+
+                  world.addComponent<BComponent>(e);
+                  world.step(Secondf { 0 });
+                  expects(system.matches(e));
+                  expects(world.hasComponent(e, BComponent::TYPE));
+
+                  world.destroyComponent<BComponent>(e);
+                  world.step(Secondf { 0 });
+                  expects(not system.matches(e));
+                  expects(world.hasComponent(e, AComponent::TYPE));
+                  expects(not world.hasComponent(e, BComponent::TYPE));
+
+                  world.destroyEntity(e);
+                  world.step(Secondf { 0 });
+                  expects(not system.matches(e));
+              } },
+          { "Signatures.overflow",
+              [] static {
+                  using Last = NumberedComponent<TYPE_COUNT - 1>;
+
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  const auto full = world.makeEntity();
+                  addNumbered(world, full, std::make_integer_sequence<UInt32, TYPE_COUNT> {});
+                  const auto partial = world.makeEntity();
+                  world.addComponent<AComponent>(partial);
+                  world.step(Secondf { 0 });
+
+                  // added last, the system mask uses an id past the inline bits
+                  const auto& system = world.addSystem<MatchingSystem<0, AComponent, Last>>();
+                  expects(system.matches(full));
+                  expects(not system.matches(partial));
+                  expects(world.hasComponent(full, Last::TYPE));
+                  expects(std::size(world.components(full)) == TYPE_COUNT);
+
+                  world.destroyComponent<Last>(full);
+                  world.addComponent<Last>(partial);
+                  world.step(Secondf { 0 });
+                  expects(not system.matches(full));
+                  expects(system.matches(partial));
+              } },
+          }
+    };
+} // namespace
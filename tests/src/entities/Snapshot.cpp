@@ -0,0 +1,330 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct PositionComponent: Component {
+        static constexpr Type TYPE = "PositionComponent"_component_type;
+
+        float x = 0.f;
+        float y = 0.f;
+    };
+
+    struct NameComponent: Component {
+        static constexpr Type TYPE = "NameComponent"_component_type;
+
+        std::string name;
+    };
+
+    /// Keeps the entities reported by the ADDED and REMOVED messages
+    class TrackingSystem final: public System {
+      public:
+        explicit TrackingSystem(EntityManager& manager)
+            : System { manager, 0, { PositionComponent::TYPE } } {}
+
+        auto update(Secondf) -> void override {}
+
+        HashSet<Entity> tracked;
+
+      private:
+        auto onMessageReceived(const Message& message) -> void override {
+            for (auto entity : message.entities) {
+                if (message.id == EntityManager::ADDED_ENTITY_MESSAGE_ID) tracked.emplace(entity);
+                else if (message.id == EntityManager::REMOVED_ENTITY_MESSAGE_ID)
+                    tracked.erase(entity);
+            }
+        }
+    };
+
+    auto makeWorld() -> EntityManager {
+        auto world = EntityManager { ExecutionMode::Deterministic };
+        world.registerComponent<PositionComponent>();
+
+        return world;
+    }
+
+    /// 3 alive entities with a position, the slot 2 was recycled once
+    auto populate(EntityManager& world) -> void {
+        for (auto i : range(3)) {
+            const auto e = world.makeEntity();
+            world.addComponent<PositionComponent>(e, PositionComponent { {}, 1.f * i });
+        }
+        world.step(Secondf { 0 });
+
+        world.destroyEntity(world.entities()[1]);
+        world.step(Secondf { 0 });
+
+        const auto e = world.makeEntity();
+        world.addComponent<PositionComponent>(e, PositionComponent { {}, 10.f });
+        world.step(Secondf { 0 });
+    }
+
+    auto save(const EntityManager& world) -> std::vector<Byte> {
+        auto stream = std::stringstream {};
+        expects(world.saveSnapshot(stream).has_value());
+
+        const auto view   = stream.view();
+        auto       buffer = std::vector<Byte>(std::size(view));
+        std::memcpy(std::data(buffer), std::data(view), std::size(view));
+
+        return buffer;
+    }
+
+    constexpr auto padded(RangeExtent size) noexcept -> RangeExtent {
+        return (size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+    }
+
+    auto readHeader(std::span<const Byte> buffer) -> SnapshotHeader {
+        auto header = SnapshotHeader {};
+        std::memcpy(&header, std::data(buffer), sizeof(SnapshotHeader));
+
+        return header;
+    }
+
+    template<class T>
+    auto patch(std::vector<Byte>& buffer, RangeExtent offset, const T& value) -> void {
+        std::memcpy(std::data(buffer) + offset, &value, sizeof(T));
+    }
+
+    /// Offsets of the sections of a snapshot with a single pool
+    struct Layout {
+        RangeExtent alive;
+        RangeExtent free_list;
+        RangeExtent pool_entities;
+    };
+
+    auto layoutOf(std::span<const Byte> buffer) -> Layout {
+        const auto header = readHeader(buffer);
+
+        const auto alive     = padded(sizeof(SnapshotHeader))
+                           + padded(header.slot_count * sizeof(EntityGeneration));
+        const auto free_list = alive + padded(header.entity_count * sizeof(Entity));
+        const auto pool      = free_list + padded(header.free_count * sizeof(EntityIndex));
+
+        return Layout { .alive         = alive,
+                        .free_list     = free_list,
+                        .pool_entities = pool + padded(sizeof(SnapshotPoolHeader)) };
+    }
+
+    auto positions(const EntityManager& world) -> std::vector<float> {
+        return world.entities() | std::views::transform([&world](auto entity) {
+                   return world.getComponent<PositionComponent>(entity).x;
+               })
+               | std::ranges::to<std::vector>();
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Snapshot",
+        {
+          { "Snapshot.roundtrip",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  const auto buffer = save(world);
+
+                  auto loaded = makeWorld();
+                  expects(loaded.loadSnapshot(buffer).has_value());
+                  expects(loaded.entities() == world.entities());
+                  expects(positions(loaded) == positions(world));
+
+                  // the generations and the free list are restored, the stale handle stays stale
+                  // and the next entities get the same handles
+                  const auto stale = entityHandle(2, 0);
+                  expects(not loaded.hasEntity(stale));
+                  const auto made        = world.makeEntity();
+                  const auto loaded_made = loaded.makeEntity();
+                  expects(made == loaded_made);
+              } },
+          { "Snapshot.rollback",
+              [] static {
+                  auto  world  = makeWorld();
+                  auto& system = world.addSystem<TrackingSystem>();
+                  populate(world);
+                  const auto buffer   = save(world);
+                  const auto expected = world.entities();
+
+                  // the ADDED message of this pending entity is queued before the rollback
+                  const auto e = world.makeEntity();
+                  world.addComponent<PositionComponent>(e);
+
+                  expects(world.loadSnapshot(buffer).has_value());
+                  world.step(Secondf { 0 });
+
+                  expects(world.entities() == expected);
+                  expects(std::size(system.tracked) == std::size(expected));
+                  expects(std::ranges::all_of(expected, [&system](auto entity) {
+                      return system.tracked.contains(entity);
+                  }));
+              } },
+          { "Snapshot.pendingCommands",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  const auto buffer   = save(world);
+                  const auto expected = world.entities();
+
+                  // recorded before the load, their reserved index may be a loaded slot
+                  const auto e = world.commands().makeEntity();
+                  world.commands().addComponent<PositionComponent>(e);
+                  world.commands().destroyEntity(expected[0]);
+
+                  expects(world.loadSnapshot(buffer).has_value());
+                  expects(world.commands().empty());
+                  world.step(Secondf { 0 });
+
+                  expects(world.entities() == expected);
+                  const auto made = world.makeEntity();
+                  world.step(Secondf { 0 });
+                  expects(world.entityCount() == std::size(expected) + 1);
+                  expects(world.hasEntity(made));
+              } },
+          { "Snapshot.unusedSlots",
+              [] static {
+                  auto world = makeWorld();
+
+                  // the slot reserved by the pending command is neither alive nor free
+                  const auto reserved = world.commands().makeEntity();
+                  const auto made     = world.makeEntity();
+                  const auto buffer   = save(world);
+
+                  auto loaded = makeWorld();
+                  expects(loaded.loadSnapshot(buffer).has_value());
+                  loaded.step(Secondf { 0 });
+                  expects(loaded.hasEntity(made));
+                  expects(not loaded.hasEntity(reserved));
+
+                  expects(loaded.makeEntity() == reserved);
+              } },
+          { "Snapshot.truncated",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  const auto buffer = save(world);
+
+                  const auto data   = std::span { buffer }.first(std::size(buffer) / 2);
+                  const auto result = world.loadSnapshot(data);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::Truncated);
+                  expects(world.entityCount() == 3);
+              } },
+          { "Snapshot.count.overflow",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  auto buffer = save(world);
+
+                  auto header         = readHeader(buffer);
+                  header.entity_count = std::numeric_limits<UInt64>::max() / 2;
+                  patch(buffer, 0, header);
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::Truncated);
+              } },
+          { "Snapshot.entity.outOfRange",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  auto       buffer = save(world);
+                  const auto layout = layoutOf(buffer);
+                  const auto before = positions(world);
+
+                  patch(buffer, layout.alive, entityHandle(1'000, 0));
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::InvalidEntity);
+                  expects(positions(world) == before);
+              } },
+          { "Snapshot.entity.stale",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  auto         buffer = save(world);
+                  const auto   layout = layoutOf(buffer);
+                  const Entity alive  = world.entities()[0];
+
+                  patch(buffer,
+                        layout.alive,
+                        entityHandle(entityIndex(alive), entityGeneration(alive) + 1));
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::InvalidEntity);
+              } },
+          { "Snapshot.freeList.alive",
+              [] static {
+                  auto world = makeWorld();
+                  world.makeEntity();
+                  world.makeEntity();
+                  world.step(Secondf { 0 });
+                  world.destroyEntity(world.entities()[1]);
+                  world.step(Secondf { 0 });
+
+                  auto       buffer = save(world);
+                  const auto layout = layoutOf(buffer);
+                  expects(readHeader(buffer).free_count == 1);
+
+                  patch(buffer, layout.free_list, entityIndex(world.entities()[0]));
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::InvalidEntity);
+              } },
+          { "Snapshot.component.ownerNotAlive",
+              [] static {
+                  auto world = makeWorld();
+                  populate(world);
+                  auto       buffer = save(world);
+                  const auto layout = layoutOf(buffer);
+
+                  patch(buffer, layout.pool_entities, entityHandle(2, 0));
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::InvalidEntity);
+                  expects(world.entityCount() == 3);
+              } },
+          { "Snapshot.payload.rejected",
+              [] static {
+                  constexpr auto save_name = [](const NameComponent&   component,
+                                                std::vector<Byte>&     output) static {
+                      const auto bytes = std::as_bytes(std::span { component.name });
+                      output.insert(std::ranges::end(output),
+                                    std::ranges::begin(bytes),
+                                    std::ranges::end(bytes));
+                  };
+                  constexpr auto reject = [](std::span<const Byte>&) static {
+                      return std::optional<NameComponent> {};
+                  };
+
+                  auto world = makeWorld();
+                  world.registerComponent<NameComponent>(save_name, reject);
+                  populate(world);
+                  world.addComponent<NameComponent>(world.entities()[0],
+                                                    NameComponent { {}, "name" });
+                  world.step(Secondf { 0 });
+                  const auto buffer = save(world);
+
+                  const auto result = world.loadSnapshot(buffer);
+                  expects(not result.has_value());
+                  expects(result.error() == SnapshotError::InvalidPayload);
+                  expects(world.entityCount() == 0);
+                  expects(world.componentPool<PositionComponent>().empty());
+              } },
+          }
+    };
+} // namespace
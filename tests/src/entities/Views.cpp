@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+import std;
+
+import stormkit.Core;
+import stormkit.Entities;
+
+import Test;
+
+using namespace stormkit;
+using namespace stormkit::entities;
+using namespace stormkit::entities::literals;
+
+#define expects(x) test::expects(x, #x)
+
+namespace {
+    struct AComponent: Component {
+        static constexpr Type TYPE = "AComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    struct BComponent: Component {
+        static constexpr Type TYPE = "BComponent"_component_type;
+
+        UInt32 value = 0;
+    };
+
+    /// Returns the entities visited by `view`, sorted
+    auto visited(const auto& view) -> std::vector<Entity> {
+        auto output = std::vector<Entity> {};
+        for (auto&& element : view) output.emplace_back(std::get<0>(element));
+        std::ranges::sort(output);
+
+        return output;
+    }
+
+    auto _ = test::TestSuite {
+        "Entities.Views",
+        {
+          { "Views.iterate",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  const auto a  = world.makeEntity();
+                  const auto ab = world.makeEntity();
+                  const auto b  = world.makeEntity();
+                  world.addComponent<AComponent>(a, AComponent { {}, 1 });
+                  world.addComponent<AComponent>(ab, AComponent { {}, 2 });
+                  world.addComponent<BComponent>(ab, BComponent { {}, 3 });
+                  world.addComponent<BComponent>(b, BComponent { {}, 4 });
+                  world.addComponent<BComponent>(world.makeEntity());
+
+                  const auto view = world.view<AComponent, const BComponent>();
+                  expects(view.sizeHint() == 2);
+                  expects(view.contains(ab));
+                  expects(not view.contains(a));
+                  expects(not view.contains(b));
+                  expects(visited(view) == std::vector { ab });
+
+                  for (auto [e, first, second] : view) {
+                      expects(e == ab);
+                      first.value += second.value;
+                  }
+                  expects(world.getComponent<AComponent>(ab).value == 5);
+
+                  auto sum = 0u;
+                  world.view<const AComponent>().each([&sum](Entity, const AComponent& component) {
+                      sum += component.value;
+                  });
+                  expects(sum == 6);
+              } },
+          { "Views.const",
+              [] static {
+                  auto       world = EntityManager { ExecutionMode::Deterministic };
+                  const auto e     = world.makeEntity();
+                  world.addComponent<AComponent>(e);
+                  world.step(Secondf { 0 });
+
+                  // reading through a const component is not a change
+                  const auto since = world.tick();
+                  for ([[maybe_unused]] auto&& _ : world.view<const AComponent>()) {}
+                  for ([[maybe_unused]] auto&& _ : std::as_const(world).view<AComponent>()) {}
+                  expects(std::empty(visited(world.changed<const AComponent>(since))));
+
+                  for ([[maybe_unused]] auto&& _ : world.view<AComponent>()) {}
+                  expects(visited(world.changed<const AComponent>(since)) == std::vector { e });
+              } },
+          { "Views.filters",
+              [] static {
+                  auto world = EntityManager { ExecutionMode::Deterministic };
+
+                  const auto old = world.makeEntity();
+                  world.addComponent<AComponent>(old);
+                  world.addComponent<BComponent>(old);
+                  world.step(Secondf { 0 });
+                  const auto since = world.tick();
+
+                  const auto fresh = world.makeEntity();
+                  world.addComponent<AComponent>(fresh);
+                  world.addComponent<BComponent>(fresh);
+                  world.getComponent<BComponent>(old).value = 1;
+
+                  const auto view = world.view<const AComponent, const BComponent>();
+                  expects(visited(view.added<AComponent>(since)) == std::vector { fresh });
+                  expects(visited(world.added<const AComponent>(since)) == std::vector { fresh });
+                  expects(visited(view.changed<AComponent>(since)) == std::vector { fresh });
+
+                  // an addition is a change too
+                  const auto both = visited(view.changed<BComponent>(since));
+                  expects(std::size(both) == 2);
+                  expects(view.changed<BComponent>(since).contains(old));
+                  expects(not view.added<BComponent>(since).contains(old));
+
+                  // the filters are combined
+                  const auto added_and_changed = view.added<AComponent>(since)
+                                                     .changed<BComponent>(since);
+                  expects(visited(added_and_changed) == std::vector { fresh });
+              } },
+          { "Views.parallelEach",
+              [] static {
+                  constexpr auto ENTITY_COUNT = 50'000u;
+
+                  auto world = EntityManager { ExecutionMode::Parallel };
+                  world.makeEntities(ENTITY_COUNT, AComponent {}, BComponent {});
+                  world.makeEntities(ENTITY_COUNT, AComponent {});
+                  world.step(Secondf { 0 });
+
+                  auto visits = std::atomic<UInt32> { 0 };
+                  world.parallelEach<AComponent, const BComponent>(
+                      [&visits](Entity e, AComponent& component, const BComponent&) {
+                          component.value = entityIndex(e);
+                          visits.fetch_add(1, std::memory_order_relaxed);
+                      },
+                      64);
+                  expects(visits.load() == ENTITY_COUNT);
+
+                  auto written = true;
+                  world.view<const AComponent, const BComponent>().each(
+                      [&written](Entity e, const AComponent& component, const BComponent&) {
+                          written = written and component.value == entityIndex(e);
+                      });
+                  expects(written);
+
+                  // every entity of the view is visited exactly once, whatever the chunk size
+                  auto* pool = world.threadPool();
+                  expects(pool != nullptr);
+                  for (auto chunk_size : { 0u, 7u, 1000u, ENTITY_COUNT * 2 }) {
+                      visits = 0;
+                      world.view<const AComponent>().parallelEach(
+                          *pool,
+                          [&visits](Entity, const AComponent&) {
+                              visits.fetch_add(1, std::memory_order_relaxed);
+                          },
+                          chunk_size);
+                      expects(visits.load() == ENTITY_COUNT * 2);
+                  }
+              } },
+          }
+    };
+} // namespace
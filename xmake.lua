@@ -269,6 +269,40 @@ option("tests_core", {
         if option:dep("tests"):enabled() then option:enable(true) end
     end,
 })
+option("tests_entities", {
+    default = false,
+    category = "root menu/others",
+    deps = { "tests", "entities" },
+    after_check = function(option)
+        if option:dep("tests"):enabled() and option:dep("entities"):enabled() then option:enable(true) end
+    end,
+})
+option("tests_engine", {
+    default = false,
+    category = "root menu/others",
+    deps = { "tests", "engine" },
+    after_check = function(option)
+        if option:dep("tests"):enabled() and option:dep("engine"):enabled() then option:enable(true) end
+    end,
+})
+
+option("benchmarks", { default = false, category = "root menu/others" })
+option("benchmarks_core", {
+    default = false,
+    category = "root menu/others",
+    deps = { "benchmarks" },
+    after_check = function(option)
+        if option:dep("benchmarks"):enabled() then option:enable(true) end
+    end,
+})
+option("benchmarks_entities", {
+    default = false,
+    category = "root menu/others",
+    deps = { "benchmarks", "entities" },
+    after_check = function(option)
+        if option:dep("benchmarks"):enabled() and option:dep("entities"):enabled() then option:enable(true) end
+    end,
+})
 
 option("sanitizers", { default = false, category = "root menu/build" })
 option("mold", { default = false, category = "root menu/build" })
@@ -549,3 +583,4 @@ for name, _ in pairs(modules) do
 end
 
 if get_config("tests") then includes("tests/xmake.lua") end
+if get_config("benchmarks") then includes("benchmarks/xmake.lua") end